@@ -23,6 +23,11 @@ backup() {
     cp -f "${src_dir}/common/unified/solver/cg_kernels.cpp" \
       "${src_dir}/common/unified/solver/cg_kernels.cpp.orig";
   fi
+  if [ -f "${src_dir}/core/solver/cg_kernels.hpp" ];
+  then
+    cp -f "${src_dir}/core/solver/cg_kernels.hpp" \
+      "${src_dir}/core/solver/cg_kernels.hpp.orig";
+  fi
   if [ -f "${src_dir}/omp/matrix/dense_kernels.cpp" ];
   then
     cp -f "${src_dir}/omp/matrix/dense_kernels.cpp" \
@@ -63,6 +68,12 @@ restore() {
     mv -f "${src_dir}/benchmark/run_all_benchmarks.sh.orig" \
       "${src_dir}/benchmark/run_all_benchmarks.sh";
   fi
+  rm -rf "${src_dir}/benchmark/omp_kernels";
+  if [ -f "${src_dir}/benchmark/CMakeLists.txt" ];
+  then
+    sed -i "/^add_subdirectory(omp_kernels)$/d" \
+      "${src_dir}/benchmark/CMakeLists.txt";
+  fi
   if [ -f "${src_dir}/common/unified/matrix/dense_kernels.instantiate.cpp.orig" ];
   then
     mv -f "${src_dir}/common/unified/matrix/dense_kernels.instantiate.cpp.orig" \
@@ -78,6 +89,20 @@ restore() {
     mv -f "${src_dir}/common/unified/solver/cg_kernels.cpp.orig" \
       "${src_dir}/common/unified/solver/cg_kernels.cpp";
   fi
+  rm -f "${src_dir}/core/device_hooks/extension_kernels.inc.cpp";
+  if [ -f "${src_dir}/core/device_hooks/common_kernels.inc.cpp" ];
+  then
+    sed -i "\\|^#include \"core/device_hooks/extension_kernels.inc.cpp\"$|d" \
+      "${src_dir}/core/device_hooks/common_kernels.inc.cpp";
+  fi
+  rm -f "${src_dir}/core/matrix/dense_fused_kernels.hpp";
+  if [ -f "${src_dir}/core/solver/cg_kernels.hpp.orig" ];
+  then
+    mv -f "${src_dir}/core/solver/cg_kernels.hpp.orig" \
+      "${src_dir}/core/solver/cg_kernels.hpp";
+  fi
+  rm -f "${src_dir}/omp/base/column_reduction.hpp";
+  rm -f "${src_dir}/omp/base/parallel_team.hpp";
   if [ -f "${src_dir}/omp/matrix/dense_kernels.cpp.orig" ];
   then
     mv -f "${src_dir}/omp/matrix/dense_kernels.cpp.orig" \
@@ -93,6 +118,24 @@ restore() {
     mv -f "${src_dir}/omp/CMakeLists.txt.orig" \
       "${src_dir}/omp/CMakeLists.txt";
   fi
+  rm -f "${src_dir}/omp/test/base/parallel_team.cpp";
+  rm -f "${src_dir}/omp/test/base/column_reduction.cpp";
+  if [ -f "${src_dir}/omp/test/base/CMakeLists.txt" ];
+  then
+    sed -i "/^ginkgo_create_omp_test(parallel_team)$/d" \
+      "${src_dir}/omp/test/base/CMakeLists.txt";
+    sed -i "/^ginkgo_create_omp_test(column_reduction)$/d" \
+      "${src_dir}/omp/test/base/CMakeLists.txt";
+  fi
+  rm -f "${src_dir}/omp/test/matrix/dense_blas1_kernels.cpp";
+  rm -f "${src_dir}/omp/test/matrix/dense_gemm_kernels.cpp";
+  if [ -f "${src_dir}/omp/test/matrix/CMakeLists.txt" ];
+  then
+    sed -i "/^ginkgo_create_omp_test(dense_blas1_kernels)$/d" \
+      "${src_dir}/omp/test/matrix/CMakeLists.txt";
+    sed -i "/^ginkgo_create_omp_test(dense_gemm_kernels)$/d" \
+      "${src_dir}/omp/test/matrix/CMakeLists.txt";
+  fi
   if [ -f "${src_dir}/reference/matrix/dense_kernels.cpp.orig" ];
   then
     mv -f "${src_dir}/reference/matrix/dense_kernels.cpp.orig" \
@@ -108,6 +151,30 @@ restore() {
     mv -f "${src_dir}/reference/CMakeLists.txt.orig" \
       "${src_dir}/reference/CMakeLists.txt";
   fi
+  rm -f "${src_dir}/test/matrix/dense_fused_kernels.cpp";
+  if [ -f "${src_dir}/test/matrix/CMakeLists.txt" ];
+  then
+    sed -i "/^ginkgo_create_common_test(dense_fused_kernels)$/d" \
+      "${src_dir}/test/matrix/CMakeLists.txt";
+  fi
+  rm -f "${src_dir}/test/solver/cg_fused_kernels.cpp";
+  rm -f "${src_dir}/test/solver/cg_pipelined_kernels.cpp";
+  rm -f "${src_dir}/test/solver/cg_deflated_kernels.cpp";
+  rm -f "${src_dir}/test/solver/cg_mixed_kernels.cpp";
+  rm -f "${src_dir}/test/solver/cg_small_width_kernels.cpp";
+  if [ -f "${src_dir}/test/solver/CMakeLists.txt" ];
+  then
+    sed -i "/^ginkgo_create_common_test(cg_fused_kernels)$/d" \
+      "${src_dir}/test/solver/CMakeLists.txt";
+    sed -i "/^ginkgo_create_common_test(cg_pipelined_kernels)$/d" \
+      "${src_dir}/test/solver/CMakeLists.txt";
+    sed -i "/^ginkgo_create_common_test(cg_deflated_kernels)$/d" \
+      "${src_dir}/test/solver/CMakeLists.txt";
+    sed -i "/^ginkgo_create_common_test(cg_mixed_kernels)$/d" \
+      "${src_dir}/test/solver/CMakeLists.txt";
+    sed -i "/^ginkgo_create_common_test(cg_small_width_kernels)$/d" \
+      "${src_dir}/test/solver/CMakeLists.txt";
+  fi
   return 0;
 }
 
@@ -116,24 +183,106 @@ apply_patches() {
   local new_dir="${src_home}/iCube/ginkgo/${ginkgo_branch}";
   cp -f "${new_dir}/benchmark/run_all_benchmarks.sh" \
     "${src_dir}/benchmark/.";
+  mkdir -p "${src_dir}/benchmark/omp_kernels";
+  cp -f "${new_dir}/benchmark/omp_kernels/CMakeLists.txt" \
+    "${new_dir}/benchmark/omp_kernels/omp_kernels.cpp" \
+    "${src_dir}/benchmark/omp_kernels/.";
+  grep -q "add_subdirectory(omp_kernels)" \
+    "${src_dir}/benchmark/CMakeLists.txt" || \
+    echo "add_subdirectory(omp_kernels)" >> \
+      "${src_dir}/benchmark/CMakeLists.txt";
   cp -f "${new_dir}/common/unified/matrix/dense_kernels.instantiate.cpp" \
     "${src_dir}/common/unified/matrix/.";
   cp -f "${new_dir}/common/unified/matrix/dense_kernels.template.cpp" \
     "${src_dir}/common/unified/matrix/.";
   cp -f "${new_dir}/common/unified/solver/cg_kernels.cpp" \
     "${src_dir}/common/unified/solver/.";
+  cp -f "${new_dir}/core/device_hooks/extension_kernels.inc.cpp" \
+    "${src_dir}/core/device_hooks/.";
+  grep -q "#include \"core/device_hooks/extension_kernels.inc.cpp\"" \
+    "${src_dir}/core/device_hooks/common_kernels.inc.cpp" || \
+    echo "#include \"core/device_hooks/extension_kernels.inc.cpp\"" >> \
+      "${src_dir}/core/device_hooks/common_kernels.inc.cpp";
+  cp -f "${new_dir}/core/matrix/dense_fused_kernels.hpp" \
+    "${src_dir}/core/matrix/.";
+  cp -f "${new_dir}/core/solver/cg_kernels.hpp" \
+    "${src_dir}/core/solver/.";
+  cp -f "${new_dir}/omp/base/column_reduction.hpp" \
+    "${src_dir}/omp/base/.";
+  cp -f "${new_dir}/omp/base/parallel_team.hpp" \
+    "${src_dir}/omp/base/.";
   cp -f "${new_dir}/omp/matrix/dense_kernels.cpp" \
     "${src_dir}/omp/matrix/.";
   cp -f "${new_dir}/omp/solver/cg_kernels.cpp" \
     "${src_dir}/omp/solver/.";
   cp -f "${new_dir}/omp/CMakeLists.txt" \
     "${src_dir}/omp/.";
+  cp -f "${new_dir}/omp/test/base/parallel_team.cpp" \
+    "${src_dir}/omp/test/base/.";
+  grep -q "ginkgo_create_omp_test(parallel_team)" \
+    "${src_dir}/omp/test/base/CMakeLists.txt" || \
+    echo "ginkgo_create_omp_test(parallel_team)" >> \
+      "${src_dir}/omp/test/base/CMakeLists.txt";
+  cp -f "${new_dir}/omp/test/base/column_reduction.cpp" \
+    "${src_dir}/omp/test/base/.";
+  grep -q "ginkgo_create_omp_test(column_reduction)" \
+    "${src_dir}/omp/test/base/CMakeLists.txt" || \
+    echo "ginkgo_create_omp_test(column_reduction)" >> \
+      "${src_dir}/omp/test/base/CMakeLists.txt";
+  cp -f "${new_dir}/omp/test/matrix/dense_blas1_kernels.cpp" \
+    "${src_dir}/omp/test/matrix/.";
+  grep -q "ginkgo_create_omp_test(dense_blas1_kernels)" \
+    "${src_dir}/omp/test/matrix/CMakeLists.txt" || \
+    echo "ginkgo_create_omp_test(dense_blas1_kernels)" >> \
+      "${src_dir}/omp/test/matrix/CMakeLists.txt";
+  cp -f "${new_dir}/omp/test/matrix/dense_gemm_kernels.cpp" \
+    "${src_dir}/omp/test/matrix/.";
+  grep -q "ginkgo_create_omp_test(dense_gemm_kernels)" \
+    "${src_dir}/omp/test/matrix/CMakeLists.txt" || \
+    echo "ginkgo_create_omp_test(dense_gemm_kernels)" >> \
+      "${src_dir}/omp/test/matrix/CMakeLists.txt";
   cp -f "${new_dir}/reference/matrix/dense_kernels.cpp" \
     "${src_dir}/reference/matrix/.";
   cp -f "${new_dir}/reference/solver/cg_kernels.cpp" \
     "${src_dir}/reference/solver/.";
   cp -f "${new_dir}/reference/CMakeLists.txt" \
     "${src_dir}/reference/.";
+  cp -f "${new_dir}/test/matrix/dense_fused_kernels.cpp" \
+    "${src_dir}/test/matrix/.";
+  grep -q "ginkgo_create_common_test(dense_fused_kernels)" \
+    "${src_dir}/test/matrix/CMakeLists.txt" || \
+    echo "ginkgo_create_common_test(dense_fused_kernels)" >> \
+      "${src_dir}/test/matrix/CMakeLists.txt";
+  cp -f "${new_dir}/test/solver/cg_fused_kernels.cpp" \
+    "${src_dir}/test/solver/.";
+  grep -q "ginkgo_create_common_test(cg_fused_kernels)" \
+    "${src_dir}/test/solver/CMakeLists.txt" || \
+    echo "ginkgo_create_common_test(cg_fused_kernels)" >> \
+      "${src_dir}/test/solver/CMakeLists.txt";
+  cp -f "${new_dir}/test/solver/cg_pipelined_kernels.cpp" \
+    "${src_dir}/test/solver/.";
+  grep -q "ginkgo_create_common_test(cg_pipelined_kernels)" \
+    "${src_dir}/test/solver/CMakeLists.txt" || \
+    echo "ginkgo_create_common_test(cg_pipelined_kernels)" >> \
+      "${src_dir}/test/solver/CMakeLists.txt";
+  cp -f "${new_dir}/test/solver/cg_deflated_kernels.cpp" \
+    "${src_dir}/test/solver/.";
+  grep -q "ginkgo_create_common_test(cg_deflated_kernels)" \
+    "${src_dir}/test/solver/CMakeLists.txt" || \
+    echo "ginkgo_create_common_test(cg_deflated_kernels)" >> \
+      "${src_dir}/test/solver/CMakeLists.txt";
+  cp -f "${new_dir}/test/solver/cg_mixed_kernels.cpp" \
+    "${src_dir}/test/solver/.";
+  grep -q "ginkgo_create_common_test(cg_mixed_kernels)" \
+    "${src_dir}/test/solver/CMakeLists.txt" || \
+    echo "ginkgo_create_common_test(cg_mixed_kernels)" >> \
+      "${src_dir}/test/solver/CMakeLists.txt";
+  cp -f "${new_dir}/test/solver/cg_small_width_kernels.cpp" \
+    "${src_dir}/test/solver/.";
+  grep -q "ginkgo_create_common_test(cg_small_width_kernels)" \
+    "${src_dir}/test/solver/CMakeLists.txt" || \
+    echo "ginkgo_create_common_test(cg_small_width_kernels)" >> \
+      "${src_dir}/test/solver/CMakeLists.txt";
   return 0;
 }
 
@@ -0,0 +1,430 @@
+/*******************************<GINKGO LICENSE>******************************
+Copyright (c) 2017-2023, the Ginkgo authors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************<GINKGO LICENSE>*******************************/
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+
+#include <ginkgo/core/base/array.hpp>
+#include <ginkgo/core/base/executor.hpp>
+#include <ginkgo/core/matrix/dense.hpp>
+#include <ginkgo/core/stop/stopping_status.hpp>
+
+
+#include "core/matrix/dense_kernels.hpp"
+#include "core/solver/cg_kernels.hpp"
+#include "omp/base/column_reduction.hpp"
+
+
+// Benchmarks of OpenMP kernels, called directly to measure them without the
+// overhead of the public API. The operations are selected with
+// --operations=<op>[,<op>...] and each measurement is printed as one JSON
+// object.
+
+
+namespace {
+
+
+using value_type = double;
+using size_type = gko::size_type;
+using Vec = gko::matrix::Dense<value_type>;
+using executor = gko::OmpExecutor;
+
+
+struct options {
+    size_type rows = size_type{1} << 20;
+    size_type cols = 16;
+    int repetitions = 10;
+    std::vector<std::string> operations;
+};
+
+
+/**
+ * Collects the measurements and prints them as a JSON array.
+ */
+class result_writer {
+public:
+    using record = std::vector<std::pair<std::string, double>>;
+
+    void add(const std::string& operation, const record& values)
+    {
+        std::ostringstream out;
+        out << "{\"operation\": \"" << operation << "\"";
+        for (const auto& value : values) {
+            out << ", \"" << value.first << "\": " << value.second;
+        }
+        out << "}";
+        results_.push_back(out.str());
+    }
+
+    void print(std::ostream& os) const
+    {
+        os << "[\n";
+        for (size_type i = 0; i < results_.size(); ++i) {
+            os << "    " << results_[i]
+               << (i + 1 < results_.size() ? ",\n" : "\n");
+        }
+        os << "]\n";
+    }
+
+private:
+    std::vector<std::string> results_;
+};
+
+
+/**
+ * Returns the average run time of `op` in seconds, after one warm-up run.
+ */
+template <typename Operation>
+double time_operation(int repetitions, Operation op)
+{
+    op();
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < repetitions; ++i) {
+        op();
+    }
+    const auto stop = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(stop - start).count() / repetitions;
+}
+
+
+std::unique_ptr<Vec> create_vector(std::shared_ptr<const executor> exec,
+                                   size_type rows, size_type cols,
+                                   value_type value)
+{
+    auto vec = Vec::create(exec, gko::dim<2>{rows, cols});
+    vec->fill(value);
+    return vec;
+}
+
+
+/**
+ * Time per iteration of the CG vector updates (step_1 and step_2) while the
+ * columns converge one half at a time, to show that stopped columns are not
+ * processed.
+ */
+void run_cg_active_columns(std::shared_ptr<const executor> exec,
+                           const options& opts, result_writer& results)
+{
+    namespace cg = gko::kernels::omp::cg;
+    const auto rows = opts.rows;
+    const auto cols = opts.cols;
+    auto x = create_vector(exec, rows, cols, 0.0);
+    auto r = create_vector(exec, rows, cols, 1.0);
+    auto z = create_vector(exec, rows, cols, 1.0);
+    auto p = create_vector(exec, rows, cols, 1.0);
+    auto q = create_vector(exec, rows, cols, 1.0);
+    // coefficients of one keep the vectors bounded over the repetitions
+    auto rho = create_vector(exec, 1, cols, 1.0);
+    auto prev_rho = create_vector(exec, 1, cols, 1.0);
+    auto beta = create_vector(exec, 1, cols, 1.0);
+    gko::array<gko::stopping_status> stop_status{exec, cols};
+    for (auto active = cols; active > 0; active /= 2) {
+        for (size_type j = 0; j < cols; ++j) {
+            stop_status.get_data()[j].reset();
+            if (j >= active) {
+                stop_status.get_data()[j].stop(1);
+            }
+        }
+        const auto time = time_operation(opts.repetitions, [&] {
+            cg::step_1(exec, p.get(), z.get(), rho.get(), prev_rho.get(),
+                       &stop_status);
+            cg::step_2(exec, x.get(), r.get(), p.get(), q.get(), beta.get(),
+                       rho.get(), &stop_status);
+        });
+        results.add("cg_active_columns",
+                    {{"rows", static_cast<double>(rows)},
+                     {"cols", static_cast<double>(cols)},
+                     {"active_cols", static_cast<double>(active)},
+                     {"time", time}});
+    }
+}
+
+
+/**
+ * Bandwidth of step_1 for 1, 2, 4 and 8 columns, all active, which uses the
+ * fixed-width implementation, and of the generic active-column loop, which
+ * step_1_deflated runs with an empty deflation basis for the same update.
+ */
+void run_cg_fixed_width(std::shared_ptr<const executor> exec,
+                        const options& opts, result_writer& results)
+{
+    namespace cg = gko::kernels::omp::cg;
+    const auto rows = opts.rows;
+    for (const size_type cols : {1, 2, 4, 8}) {
+        auto z = create_vector(exec, rows, cols, 1.0);
+        auto p = create_vector(exec, rows, cols, 1.0);
+        auto basis = create_vector(exec, rows, 0, 0.0);
+        auto mu = create_vector(exec, 0, cols, 0.0);
+        // a coefficient of one keeps p bounded over the repetitions
+        auto rho = create_vector(exec, 1, cols, 1.0);
+        auto prev_rho = create_vector(exec, 1, cols, 1.0);
+        gko::array<gko::stopping_status> stop_status{exec, cols};
+        for (size_type j = 0; j < cols; ++j) {
+            stop_status.get_data()[j].reset();
+        }
+        const auto fixed_time = time_operation(opts.repetitions, [&] {
+            cg::step_1(exec, p.get(), z.get(), rho.get(), prev_rho.get(),
+                       &stop_status);
+        });
+        const auto generic_time = time_operation(opts.repetitions, [&] {
+            cg::step_1_deflated(exec, p.get(), z.get(), basis.get(), mu.get(),
+                                rho.get(), prev_rho.get(), &stop_status);
+        });
+        const auto bytes = 3.0 * rows * cols * sizeof(value_type);
+        for (const auto& entry :
+             {std::make_pair("cg_fixed_width_fixed", fixed_time),
+              std::make_pair("cg_fixed_width_generic", generic_time)}) {
+            results.add(entry.first,
+                        {{"rows", static_cast<double>(rows)},
+                         {"cols", static_cast<double>(cols)},
+                         {"time", entry.second},
+                         {"bandwidth", bytes / entry.second * 1e-9}});
+        }
+    }
+}
+
+
+/**
+ * STREAM-style bandwidth of the CG update step_1 (p = z + p, reading z and p
+ * and writing p) with the vectors first touched either by a single thread or
+ * by the parallel cg::initialize, to show the effect of the page placement on
+ * NUMA systems.
+ */
+void run_cg_first_touch(std::shared_ptr<const executor> exec,
+                        const options& opts, result_writer& results)
+{
+    namespace cg = gko::kernels::omp::cg;
+    const auto rows = opts.rows;
+    const auto cols = opts.cols;
+    for (const auto parallel : {false, true}) {
+        auto b = create_vector(exec, rows, cols, 1.0);
+        auto r = Vec::create(exec, gko::dim<2>{rows, cols});
+        auto z = Vec::create(exec, gko::dim<2>{rows, cols});
+        auto p = Vec::create(exec, gko::dim<2>{rows, cols});
+        auto q = Vec::create(exec, gko::dim<2>{rows, cols});
+        auto rho = create_vector(exec, 1, cols, 1.0);
+        auto prev_rho = create_vector(exec, 1, cols, 1.0);
+        gko::array<gko::stopping_status> stop_status{exec, cols};
+        if (parallel) {
+            cg::initialize(exec, b.get(), r.get(), z.get(), p.get(), q.get(),
+                           prev_rho.get(), rho.get(), &stop_status);
+        } else {
+            for (size_type i = 0; i < rows; ++i) {
+                for (size_type j = 0; j < cols; ++j) {
+                    r->at(i, j) = z->at(i, j) = p->at(i, j) = q->at(i, j) =
+                        0.0;
+                }
+            }
+            for (size_type j = 0; j < cols; ++j) {
+                stop_status.get_data()[j].reset();
+            }
+        }
+        rho->fill(1.0);
+        prev_rho->fill(1.0);
+        const auto time = time_operation(opts.repetitions, [&] {
+            cg::step_1(exec, p.get(), z.get(), rho.get(), prev_rho.get(),
+                       &stop_status);
+        });
+        const auto bytes = 3.0 * rows * cols * sizeof(value_type);
+        results.add(parallel ? "cg_first_touch_parallel"
+                             : "cg_first_touch_serial",
+                    {{"rows", static_cast<double>(rows)},
+                     {"cols", static_cast<double>(cols)},
+                     {"time", time},
+                     {"bandwidth", bytes / time * 1e-9}});
+    }
+}
+
+
+/**
+ * GFLOP/s of the dense product C = A * B for the shapes of the block solvers:
+ * a square product, a block of vectors times a small matrix, and the Gram
+ * matrix of a block of vectors, where `cols` is the block size.
+ */
+void run_dense_apply(std::shared_ptr<const executor> exec,
+                     const options& opts, result_writer& results)
+{
+    namespace dense = gko::kernels::omp::dense;
+    const auto rows = opts.rows;
+    const auto cols = opts.cols;
+    const size_type square = 1024;
+    const std::vector<std::pair<std::string, gko::dim<3>>> shapes{
+        {"square", {square, square, square}},
+        {"block_times_small", {rows, cols, cols}},
+        {"gram", {cols, rows, cols}}};
+    for (const auto& shape : shapes) {
+        const auto size = shape.second;
+        auto a = create_vector(exec, size[0], size[1], 1.0);
+        auto b = create_vector(exec, size[1], size[2], 1.0);
+        auto c = create_vector(exec, size[0], size[2], 0.0);
+        const auto time = time_operation(opts.repetitions, [&] {
+            dense::simple_apply(exec, a.get(), b.get(), c.get());
+        });
+        const auto flops = 2.0 * size[0] * size[1] * size[2];
+        results.add("dense_apply_" + shape.first,
+                    {{"m", static_cast<double>(size[0])},
+                     {"k", static_cast<double>(size[1])},
+                     {"n", static_cast<double>(size[2])},
+                     {"time", time},
+                     {"gflops", flops / time * 1e-9}});
+    }
+}
+
+
+/**
+ * Throughput of the column-wise dot product of two vectors with the
+ * reproducible reduction, whose result does not depend on the number of
+ * threads, and with the fast reduction used by default.
+ */
+void run_reduction(std::shared_ptr<const executor> exec, const options& opts,
+                   result_writer& results)
+{
+    namespace omp = gko::kernels::omp;
+    const auto rows = opts.rows;
+    const auto cols = opts.cols;
+    auto x = create_vector(exec, rows, cols, 1.0);
+    auto y = create_vector(exec, rows, cols, 1.0);
+    auto result = create_vector(exec, 1, cols, 0.0);
+    gko::array<char> tmp{exec};
+    const auto op = [&](size_type i, size_type j) {
+        return x->at(i, j) * y->at(i, j);
+    };
+    const auto finalize = [](value_type val) { return val; };
+    const auto bytes = 2.0 * rows * cols * sizeof(value_type);
+    const auto reproducible_time = time_operation(opts.repetitions, [&] {
+        omp::reduce_columns_reproducible(x->get_size(), result.get(), tmp, op,
+                                         finalize);
+    });
+    const auto fast_time = time_operation(opts.repetitions, [&] {
+        omp::reduce_columns_fast(x->get_size(),
+                                 omp::get_row_block_size(x.get()),
+                                 result.get(), tmp, op, finalize);
+    });
+    for (const auto& entry : {std::make_pair("reduction_reproducible",
+                                             reproducible_time),
+                              std::make_pair("reduction_fast", fast_time)}) {
+        results.add(entry.first, {{"rows", static_cast<double>(rows)},
+                                  {"cols", static_cast<double>(cols)},
+                                  {"time", entry.second},
+                                  {"bandwidth", bytes / entry.second * 1e-9}});
+    }
+}
+
+
+using operation = std::function<void(std::shared_ptr<const executor>,
+                                     const options&, result_writer&)>;
+
+
+const std::map<std::string, operation> operation_map{
+    {"cg_active_columns", run_cg_active_columns},
+    {"cg_first_touch", run_cg_first_touch},
+    {"cg_fixed_width", run_cg_fixed_width},
+    {"dense_apply", run_dense_apply},
+    {"reduction", run_reduction}};
+
+
+std::vector<std::string> split(const std::string& list)
+{
+    std::vector<std::string> items;
+    std::istringstream in{list};
+    for (std::string item; std::getline(in, item, ',');) {
+        items.push_back(item);
+    }
+    return items;
+}
+
+
+void print_usage(const char* name)
+{
+    std::cerr << "Usage: " << name
+              << " [--rows=<n>] [--cols=<n>] [--repetitions=<n>]"
+                 " [--operations=<op>[,<op>...]]\nAvailable operations:";
+    for (const auto& entry : operation_map) {
+        std::cerr << " " << entry.first;
+    }
+    std::cerr << "\n";
+}
+
+
+}  // namespace
+
+
+int main(int argc, char* argv[])
+{
+    options opts;
+    for (auto& entry : operation_map) {
+        opts.operations.push_back(entry.first);
+    }
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg{argv[i]};
+        const auto pos = arg.find('=');
+        const auto key = arg.substr(0, pos);
+        const auto value = pos == std::string::npos ? "" : arg.substr(pos + 1);
+        if (key == "--rows") {
+            opts.rows = std::stoull(value);
+        } else if (key == "--cols") {
+            opts.cols = std::stoull(value);
+        } else if (key == "--repetitions") {
+            opts.repetitions = std::stoi(value);
+        } else if (key == "--operations") {
+            opts.operations = split(value);
+        } else {
+            print_usage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+    for (const auto& name : opts.operations) {
+        if (operation_map.find(name) == operation_map.end()) {
+            std::cerr << "Unknown operation " << name << "\n";
+            print_usage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    auto exec = executor::create();
+    result_writer results;
+    for (const auto& name : opts.operations) {
+        std::cerr << "Running " << name << std::endl;
+        operation_map.at(name)(exec, opts, results);
+    }
+    results.print(std::cout);
+}
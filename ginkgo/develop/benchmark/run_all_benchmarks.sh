@@ -311,6 +311,28 @@ run_preconditioner_benchmarks() {
 }
 
 
+# Runs the benchmarks of the OpenMP kernels, which generate their own data, and
+# stores the results in file $1. The operations can be selected with the
+# OMP_KERNELS_OPERATIONS environment variable, all of them are run otherwise.
+run_omp_kernel_benchmarks() {
+    [ "${DRY_RUN}" == "true" ] && return
+    local operations_flag=""
+    if [ "${OMP_KERNELS_OPERATIONS}" ]; then
+        operations_flag="--operations=${OMP_KERNELS_OPERATIONS}"
+    fi
+    ./omp_kernels/omp_kernels --repetitions="${REPETITIONS}" \
+        ${operations_flag} >"$1"
+}
+
+if [ "${BENCHMARK}" == "omp_kernels" ]; then
+    RESULT_FILE="results/${SYSTEM_NAME}/omp/omp_kernels.json"
+    mkdir -p "$(dirname "${RESULT_FILE}")"
+    echo -e "Running OpenMP kernel benchmarks" 1>&2
+    run_omp_kernel_benchmarks "${RESULT_FILE}"
+    exit
+fi
+
+
 ################################################################################
 # SuiteSparse collection
 
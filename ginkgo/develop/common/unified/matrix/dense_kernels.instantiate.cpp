@@ -53,6 +53,8 @@ GKO_INSTANTIATE_FOR_EACH_VALUE_AND_SCALAR_TYPE(
     GKO_DECLARE_DENSE_INV_SCALE_KERNEL);
 GKO_INSTANTIATE_FOR_EACH_VALUE_AND_SCALAR_TYPE(
     GKO_DECLARE_DENSE_ADD_SCALED_KERNEL);
+GKO_INSTANTIATE_FOR_EACH_VALUE_AND_SCALAR_TYPE(
+    GKO_DECLARE_DENSE_SCALE_ADD_SCALED_KERNEL);
 GKO_INSTANTIATE_FOR_EACH_VALUE_AND_SCALAR_TYPE(
     GKO_DECLARE_DENSE_SUB_SCALED_KERNEL);
 GKO_INSTANTIATE_FOR_EACH_VALUE_TYPE(GKO_DECLARE_DENSE_ADD_SCALED_DIAG_KERNEL);
@@ -102,6 +104,9 @@ GKO_INSTANTIATE_FOR_EACH_VALUE_TYPE(
 // split
 GKO_INSTANTIATE_FOR_EACH_VALUE_TYPE(
     GKO_DECLARE_DENSE_COMPUTE_SQUARED_NORM2_KERNEL);
+// split
+GKO_INSTANTIATE_FOR_EACH_VALUE_TYPE(
+    GKO_DECLARE_DENSE_COMPUTE_MULTI_CONJ_DOT_KERNEL);
 // end
 
 
@@ -44,6 +44,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "common/unified/base/kernel_launch_reduction.hpp"
 #include "core/base/mixed_precision_types.hpp"
 #include "core/components/prefix_sum_kernels.hpp"
+#include "core/matrix/dense_fused_kernels.hpp"
 
 
 namespace gko {
@@ -167,6 +168,31 @@ void add_scaled(std::shared_ptr<const DefaultExecutor> exec,
 }
 
 
+template <typename ValueType, typename ScalarType>
+void scale_add_scaled(std::shared_ptr<const DefaultExecutor> exec,
+                      const matrix::Dense<ScalarType>* beta,
+                      const matrix::Dense<ScalarType>* alpha,
+                      const matrix::Dense<ValueType>* x,
+                      matrix::Dense<ValueType>* y)
+{
+    run_kernel(
+        exec,
+        [] GKO_KERNEL(auto row, auto col, auto beta, auto beta_step,
+                      auto alpha, auto alpha_step, auto x, auto y) {
+            const auto vbeta = beta[col * beta_step];
+            const auto valpha = alpha[col * alpha_step];
+            const auto scaled =
+                is_zero(vbeta) ? zero(y(row, col)) : y(row, col) * vbeta;
+            y(row, col) =
+                is_zero(valpha) ? scaled : scaled + valpha * x(row, col);
+        },
+        x->get_size(), beta->get_const_values(),
+        static_cast<int64>(beta->get_size()[1] > 1),
+        alpha->get_const_values(),
+        static_cast<int64>(alpha->get_size()[1] > 1), x, y);
+}
+
+
 template <typename ValueType, typename ScalarType>
 void sub_scaled(std::shared_ptr<const DefaultExecutor> exec,
                 const matrix::Dense<ScalarType>* alpha,
@@ -254,6 +280,22 @@ void compute_conj_dot(std::shared_ptr<const DefaultExecutor> exec,
 }
 
 
+template <typename ValueType>
+void compute_multi_conj_dot(std::shared_ptr<const DefaultExecutor> exec,
+                            const matrix::Dense<ValueType>* x,
+                            const matrix::Dense<ValueType>* y,
+                            matrix::Dense<ValueType>* result, array<char>& tmp)
+{
+    run_kernel_col_reduction_cached(
+        exec,
+        [] GKO_KERNEL(auto i, auto j, auto x, auto y, auto num_cols) {
+            return conj(x(i, j % num_cols)) * y(i, j);
+        },
+        GKO_KERNEL_REDUCE_SUM(ValueType), result->get_values(), y->get_size(),
+        tmp, x, y, static_cast<int64>(x->get_size()[1]));
+}
+
+
 template <typename ValueType>
 void compute_norm2(std::shared_ptr<const DefaultExecutor> exec,
                    const matrix::Dense<ValueType>* x,
@@ -573,9 +615,11 @@ void add_scaled_identity(std::shared_ptr<const DefaultExecutor> exec,
     run_kernel(
         exec,
         [] GKO_KERNEL(auto row, auto col, auto alpha, auto beta, auto mtx) {
-            mtx(row, col) = beta[0] * mtx(row, col);
+            // for beta == 1, only the diagonal changes
             if (row == col) {
-                mtx(row, row) += alpha[0];
+                mtx(row, row) = beta[0] * mtx(row, row) + alpha[0];
+            } else if (beta[0] != one(beta[0])) {
+                mtx(row, col) = beta[0] * mtx(row, col);
             }
         },
         mtx->get_size(), alpha->get_const_values(), beta->get_const_values(),
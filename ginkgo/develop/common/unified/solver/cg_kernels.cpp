@@ -36,9 +36,13 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "core/solver/cg_kernels.hpp"
 
 
+#include <type_traits>
+
+
 #include <ginkgo/core/base/math.hpp>
 
 
+#include "common/unified/base/kernel_launch_reduction.hpp"
 #include "common/unified/base/kernel_launch_solver.hpp"
 
 
@@ -142,6 +146,290 @@ void step_2(std::shared_ptr<const DefaultExecutor> exec,
 GKO_INSTANTIATE_FOR_EACH_VALUE_TYPE(GKO_DECLARE_CG_STEP_2_KERNEL);
 
 
+template <typename ValueType>
+void step_2_fused(std::shared_ptr<const DefaultExecutor> exec,
+                  matrix::Dense<ValueType>* x, matrix::Dense<ValueType>* r,
+                  const matrix::Dense<ValueType>* p,
+                  const matrix::Dense<ValueType>* q,
+                  const matrix::Dense<ValueType>* beta,
+                  matrix::Dense<ValueType>* prev_rho,
+                  matrix::Dense<ValueType>* rho, array<char>& tmp,
+                  const array<stopping_status>* stop_status)
+{
+    run_kernel(
+        exec,
+        [] GKO_KERNEL(auto col, auto rho, auto prev_rho) {
+            prev_rho[col] = rho[col];
+        },
+        x->get_size()[1], row_vector(rho), row_vector(prev_rho));
+    // the step length is computed from prev_rho, since rho is the output of
+    // the reduction
+    run_kernel_col_reduction_cached(
+        exec,
+        [] GKO_KERNEL(auto row, auto col, auto x, auto r, auto p, auto q,
+                      auto beta, auto prev_rho, auto stop) {
+            if (!stop[col].has_stopped()) {
+                auto alpha = safe_divide(prev_rho[col], beta[col]);
+                x(row, col) += alpha * p(row, col);
+                r(row, col) -= alpha * q(row, col);
+            }
+            return conj(r(row, col)) * r(row, col);
+        },
+        GKO_KERNEL_REDUCE_SUM(ValueType), rho->get_values(), x->get_size(), tmp,
+        x, r, p, q, row_vector(beta), row_vector(prev_rho), *stop_status);
+}
+
+GKO_INSTANTIATE_FOR_EACH_VALUE_TYPE(GKO_DECLARE_CG_STEP_2_FUSED_KERNEL);
+
+
+template <typename ValueType>
+void step_2_jacobi(std::shared_ptr<const DefaultExecutor> exec,
+                   matrix::Dense<ValueType>* x, matrix::Dense<ValueType>* r,
+                   matrix::Dense<ValueType>* z,
+                   const matrix::Dense<ValueType>* p,
+                   const matrix::Dense<ValueType>* q,
+                   const matrix::Diagonal<ValueType>* inv_diag,
+                   const matrix::Dense<ValueType>* beta,
+                   matrix::Dense<ValueType>* prev_rho,
+                   matrix::Dense<ValueType>* rho, array<char>& tmp,
+                   const array<stopping_status>* stop_status)
+{
+    run_kernel(
+        exec,
+        [] GKO_KERNEL(auto col, auto rho, auto prev_rho) {
+            prev_rho[col] = rho[col];
+        },
+        x->get_size()[1], row_vector(rho), row_vector(prev_rho));
+    run_kernel_col_reduction_cached(
+        exec,
+        [] GKO_KERNEL(auto row, auto col, auto x, auto r, auto z, auto p,
+                      auto q, auto inv_diag, auto beta, auto prev_rho,
+                      auto stop) {
+            if (!stop[col].has_stopped()) {
+                auto alpha = safe_divide(prev_rho[col], beta[col]);
+                x(row, col) += alpha * p(row, col);
+                r(row, col) -= alpha * q(row, col);
+            }
+            z(row, col) = inv_diag[row] * r(row, col);
+            return conj(r(row, col)) * z(row, col);
+        },
+        GKO_KERNEL_REDUCE_SUM(ValueType), rho->get_values(), x->get_size(), tmp,
+        x, r, z, p, q, inv_diag->get_const_values(), row_vector(beta),
+        row_vector(prev_rho), *stop_status);
+}
+
+GKO_INSTANTIATE_FOR_EACH_VALUE_TYPE(GKO_DECLARE_CG_STEP_2_JACOBI_KERNEL);
+
+
+template <typename ValueType>
+void initialize_pipelined(std::shared_ptr<const DefaultExecutor> exec,
+                          const matrix::Dense<ValueType>* b,
+                          matrix::Dense<ValueType>* r,
+                          matrix::Dense<ValueType>* p,
+                          matrix::Dense<ValueType>* q,
+                          matrix::Dense<ValueType>* s,
+                          matrix::Dense<ValueType>* z,
+                          matrix::Dense<ValueType>* prev_rho,
+                          matrix::Dense<ValueType>* alpha,
+                          array<stopping_status>* stop_status)
+{
+    run_kernel(
+        exec,
+        [] GKO_KERNEL(auto col, auto prev_rho, auto alpha, auto stop) {
+            prev_rho[col] = zero(prev_rho[col]);
+            alpha[col] = one(alpha[col]);
+            stop[col].reset();
+        },
+        b->get_size()[1], row_vector(prev_rho), row_vector(alpha),
+        *stop_status);
+    if (b->get_size()) {
+        run_kernel_solver(
+            exec,
+            [] GKO_KERNEL(auto row, auto col, auto b, auto r, auto p, auto q,
+                          auto s, auto z) {
+                r(row, col) = b(row, col);
+                p(row, col) = q(row, col) = s(row, col) = z(row, col) =
+                    zero(p(row, col));
+            },
+            b->get_size(), b->get_stride(), b, default_stride(r),
+            default_stride(p), default_stride(q), default_stride(s),
+            default_stride(z));
+    }
+}
+
+GKO_INSTANTIATE_FOR_EACH_VALUE_TYPE(GKO_DECLARE_CG_INITIALIZE_PIPELINED_KERNEL);
+
+
+template <typename ValueType>
+void step_1_pipelined(std::shared_ptr<const DefaultExecutor> exec,
+                      const matrix::Dense<ValueType>* r,
+                      const matrix::Dense<ValueType>* u,
+                      const matrix::Dense<ValueType>* w,
+                      matrix::Dense<ValueType>* dots, array<char>& tmp)
+{
+    const auto num_cols = static_cast<int64>(r->get_size()[1]);
+    // the first num_cols columns of the iteration space compute r^H u, the
+    // others w^H u
+    run_kernel_col_reduction_cached(
+        exec,
+        [] GKO_KERNEL(auto row, auto col, auto r, auto u, auto w,
+                      auto num_cols) {
+            return col < num_cols
+                       ? conj(r(row, col)) * u(row, col)
+                       : conj(w(row, col - num_cols)) * u(row, col - num_cols);
+        },
+        GKO_KERNEL_REDUCE_SUM(ValueType), dots->get_values(),
+        dim<2>{r->get_size()[0], 2 * r->get_size()[1]}, tmp, r, u, w,
+        num_cols);
+}
+
+GKO_INSTANTIATE_FOR_EACH_VALUE_TYPE(GKO_DECLARE_CG_STEP_1_PIPELINED_KERNEL);
+
+
+template <typename ValueType>
+void step_2_pipelined(
+    std::shared_ptr<const DefaultExecutor> exec, matrix::Dense<ValueType>* x,
+    matrix::Dense<ValueType>* r, matrix::Dense<ValueType>* u,
+    matrix::Dense<ValueType>* w, matrix::Dense<ValueType>* p,
+    matrix::Dense<ValueType>* q, matrix::Dense<ValueType>* s,
+    matrix::Dense<ValueType>* z, const matrix::Dense<ValueType>* m,
+    const matrix::Dense<ValueType>* n, const matrix::Dense<ValueType>* dots,
+    matrix::Dense<ValueType>* prev_rho, matrix::Dense<ValueType>* alpha,
+    const array<stopping_status>* stop_status)
+{
+    const auto num_cols = static_cast<int64>(x->get_size()[1]);
+    run_kernel_solver(
+        exec,
+        [] GKO_KERNEL(auto row, auto col, auto x, auto r, auto u, auto w,
+                      auto p, auto q, auto s, auto z, auto m, auto n,
+                      auto dots, auto prev_rho, auto alpha, auto num_cols,
+                      auto stop) {
+            if (!stop[col].has_stopped()) {
+                const auto gamma = dots[col];
+                const auto beta = safe_divide(gamma, prev_rho[col]);
+                const auto step = safe_divide(
+                    gamma, dots[num_cols + col] -
+                               safe_divide(beta * gamma, alpha[col]));
+                z(row, col) = n(row, col) + beta * z(row, col);
+                q(row, col) = m(row, col) + beta * q(row, col);
+                s(row, col) = w(row, col) + beta * s(row, col);
+                p(row, col) = u(row, col) + beta * p(row, col);
+                x(row, col) += step * p(row, col);
+                r(row, col) -= step * s(row, col);
+                u(row, col) -= step * q(row, col);
+                w(row, col) -= step * z(row, col);
+            }
+        },
+        x->get_size(), r->get_stride(), x, default_stride(r), u, w, p, q, s,
+        z, m, n, row_vector(dots), row_vector(prev_rho), row_vector(alpha),
+        num_cols, *stop_status);
+    // the coefficients are only updated once all entries used the old ones
+    run_kernel(
+        exec,
+        [] GKO_KERNEL(auto col, auto dots, auto prev_rho, auto alpha,
+                      auto num_cols, auto stop) {
+            if (!stop[col].has_stopped()) {
+                const auto gamma = dots[col];
+                const auto beta = safe_divide(gamma, prev_rho[col]);
+                alpha[col] = safe_divide(
+                    gamma, dots[num_cols + col] -
+                               safe_divide(beta * gamma, alpha[col]));
+                prev_rho[col] = gamma;
+            }
+        },
+        num_cols, row_vector(dots), row_vector(prev_rho), row_vector(alpha),
+        num_cols, *stop_status);
+}
+
+GKO_INSTANTIATE_FOR_EACH_VALUE_TYPE(GKO_DECLARE_CG_STEP_2_PIPELINED_KERNEL);
+
+
+template <typename ValueType>
+void step_1_deflated(std::shared_ptr<const DefaultExecutor> exec,
+                     matrix::Dense<ValueType>* p,
+                     const matrix::Dense<ValueType>* z,
+                     const matrix::Dense<ValueType>* basis,
+                     const matrix::Dense<ValueType>* mu,
+                     const matrix::Dense<ValueType>* rho,
+                     const matrix::Dense<ValueType>* prev_rho,
+                     const array<stopping_status>* stop_status)
+{
+    run_kernel_solver(
+        exec,
+        [] GKO_KERNEL(auto row, auto col, auto p, auto z, auto basis, auto mu,
+                      auto num_vectors, auto rho, auto prev_rho, auto stop) {
+            if (!stop[col].has_stopped()) {
+                const auto beta = safe_divide(rho[col], prev_rho[col]);
+                auto val = z(row, col) + beta * p(row, col);
+                for (int64 l = 0; l < num_vectors; ++l) {
+                    val -= basis(row, l) * mu(l, col);
+                }
+                p(row, col) = val;
+            }
+        },
+        p->get_size(), p->get_stride(), default_stride(p), default_stride(z),
+        basis, mu, static_cast<int64>(basis->get_size()[1]), row_vector(rho),
+        row_vector(prev_rho), *stop_status);
+}
+
+GKO_INSTANTIATE_FOR_EACH_VALUE_TYPE(GKO_DECLARE_CG_STEP_1_DEFLATED_KERNEL);
+
+
+template <typename StorageType, typename ValueType>
+void step_1_mixed(std::shared_ptr<const DefaultExecutor> exec,
+                  matrix::Dense<StorageType>* p,
+                  const matrix::Dense<StorageType>* z,
+                  const matrix::Dense<ValueType>* rho,
+                  const matrix::Dense<ValueType>* prev_rho,
+                  const array<stopping_status>* stop_status)
+{
+    run_kernel_solver(
+        exec,
+        [] GKO_KERNEL(auto row, auto col, auto p, auto z, auto rho,
+                      auto prev_rho, auto stop) {
+            using arithmetic_type = std::decay_t<decltype(rho[col])>;
+            using storage_type = std::decay_t<decltype(p(row, col))>;
+            if (!stop[col].has_stopped()) {
+                const auto beta = safe_divide(rho[col], prev_rho[col]);
+                p(row, col) = static_cast<storage_type>(
+                    static_cast<arithmetic_type>(z(row, col)) +
+                    beta * static_cast<arithmetic_type>(p(row, col)));
+            }
+        },
+        p->get_size(), p->get_stride(), default_stride(p), default_stride(z),
+        row_vector(rho), row_vector(prev_rho), *stop_status);
+}
+
+GKO_INSTANTIATE_FOR_EACH_VALUE_CONVERSION(GKO_DECLARE_CG_STEP_1_MIXED_KERNEL);
+
+
+template <typename StorageType, typename ValueType>
+void step_2_mixed(std::shared_ptr<const DefaultExecutor> exec,
+                  matrix::Dense<ValueType>* x, matrix::Dense<ValueType>* r,
+                  const matrix::Dense<StorageType>* p,
+                  const matrix::Dense<StorageType>* q,
+                  const matrix::Dense<ValueType>* beta,
+                  const matrix::Dense<ValueType>* rho,
+                  const array<stopping_status>* stop_status)
+{
+    run_kernel_solver(
+        exec,
+        [] GKO_KERNEL(auto row, auto col, auto x, auto r, auto p, auto q,
+                      auto beta, auto rho, auto stop) {
+            using arithmetic_type = std::decay_t<decltype(rho[col])>;
+            if (!stop[col].has_stopped()) {
+                const auto step = safe_divide(rho[col], beta[col]);
+                x(row, col) += step * static_cast<arithmetic_type>(p(row, col));
+                r(row, col) -= step * static_cast<arithmetic_type>(q(row, col));
+            }
+        },
+        x->get_size(), r->get_stride(), x, r, p, q, row_vector(beta),
+        row_vector(rho), *stop_status);
+}
+
+GKO_INSTANTIATE_FOR_EACH_VALUE_CONVERSION(GKO_DECLARE_CG_STEP_2_MIXED_KERNEL);
+
+
 }  // namespace cg
 }  // namespace GKO_DEVICE_NAMESPACE
 }  // namespace kernels
@@ -0,0 +1,101 @@
+/*******************************<GINKGO LICENSE>******************************
+Copyright (c) 2017-2023, the Ginkgo authors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************<GINKGO LICENSE>*******************************/
+
+// Stubs for the kernels added on top of the upstream kernel headers. This file
+// is included at the end of core/device_hooks/common_kernels.inc.cpp, so every
+// backend that is not compiled still provides the symbols.
+
+
+#include <ginkgo/core/base/exception_helpers.hpp>
+
+
+#include "core/matrix/dense_fused_kernels.hpp"
+#include "core/solver/cg_kernels.hpp"
+
+
+#ifndef GKO_HOOK_MODULE
+#error "Need to define GKO_HOOK_MODULE variable before including this file"
+#endif  // GKO_HOOK_MODULE
+
+
+#define GKO_EXTENSION_STUB_VALUE_TYPE(_macro)            \
+    template <typename ValueType>                        \
+    _macro(ValueType) GKO_NOT_COMPILED(GKO_HOOK_MODULE); \
+    GKO_INSTANTIATE_FOR_EACH_VALUE_TYPE(_macro)
+
+#define GKO_EXTENSION_STUB_VALUE_AND_SCALAR_TYPE(_macro)             \
+    template <typename ValueType, typename ScalarType>               \
+    _macro(ValueType, ScalarType) GKO_NOT_COMPILED(GKO_HOOK_MODULE); \
+    GKO_INSTANTIATE_FOR_EACH_VALUE_AND_SCALAR_TYPE(_macro)
+
+#define GKO_EXTENSION_STUB_VALUE_CONVERSION(_macro)                   \
+    template <typename StorageType, typename ValueType>               \
+    _macro(StorageType, ValueType) GKO_NOT_COMPILED(GKO_HOOK_MODULE); \
+    GKO_INSTANTIATE_FOR_EACH_VALUE_CONVERSION(_macro)
+
+
+namespace gko {
+namespace kernels {
+namespace GKO_HOOK_MODULE {
+namespace dense {
+
+
+GKO_EXTENSION_STUB_VALUE_TYPE(GKO_DECLARE_DENSE_COMPUTE_MULTI_CONJ_DOT_KERNEL);
+GKO_EXTENSION_STUB_VALUE_AND_SCALAR_TYPE(
+    GKO_DECLARE_DENSE_SCALE_ADD_SCALED_KERNEL);
+
+
+}  // namespace dense
+
+
+namespace cg {
+
+
+GKO_EXTENSION_STUB_VALUE_TYPE(GKO_DECLARE_CG_STEP_2_FUSED_KERNEL);
+GKO_EXTENSION_STUB_VALUE_TYPE(GKO_DECLARE_CG_STEP_2_JACOBI_KERNEL);
+GKO_EXTENSION_STUB_VALUE_TYPE(GKO_DECLARE_CG_INITIALIZE_PIPELINED_KERNEL);
+GKO_EXTENSION_STUB_VALUE_TYPE(GKO_DECLARE_CG_STEP_1_PIPELINED_KERNEL);
+GKO_EXTENSION_STUB_VALUE_TYPE(GKO_DECLARE_CG_STEP_2_PIPELINED_KERNEL);
+GKO_EXTENSION_STUB_VALUE_TYPE(GKO_DECLARE_CG_STEP_1_DEFLATED_KERNEL);
+GKO_EXTENSION_STUB_VALUE_CONVERSION(GKO_DECLARE_CG_STEP_1_MIXED_KERNEL);
+GKO_EXTENSION_STUB_VALUE_CONVERSION(GKO_DECLARE_CG_STEP_2_MIXED_KERNEL);
+
+
+}  // namespace cg
+}  // namespace GKO_HOOK_MODULE
+}  // namespace kernels
+}  // namespace gko
+
+
+#undef GKO_EXTENSION_STUB_VALUE_TYPE
+#undef GKO_EXTENSION_STUB_VALUE_AND_SCALAR_TYPE
+#undef GKO_EXTENSION_STUB_VALUE_CONVERSION
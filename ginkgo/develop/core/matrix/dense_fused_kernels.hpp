@@ -0,0 +1,101 @@
+/*******************************<GINKGO LICENSE>******************************
+Copyright (c) 2017-2023, the Ginkgo authors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************<GINKGO LICENSE>*******************************/
+
+#ifndef GKO_CORE_MATRIX_DENSE_FUSED_KERNELS_HPP_
+#define GKO_CORE_MATRIX_DENSE_FUSED_KERNELS_HPP_
+
+
+#include <memory>
+
+
+#include <ginkgo/core/base/array.hpp>
+#include <ginkgo/core/base/types.hpp>
+#include <ginkgo/core/matrix/dense.hpp>
+
+
+#include "core/base/kernel_declaration.hpp"
+
+
+namespace gko {
+namespace kernels {
+
+
+/**
+ * Computes several conjugate dot products with a shared left-hand side in a
+ * single pass over the vectors.
+ *
+ * `y` consists of k blocks of as many columns as `x`, and
+ * result(0, b * n + j) = x_j^H y_{b * n + j} for the n columns of `x` and all
+ * blocks b. A solver that keeps the vectors it needs to reduce against the
+ * same vector as column blocks of one Dense, e.g. [z r] for r^H z and r^H r,
+ * gets all results at the cost of streaming `x` once. Norms follow from the
+ * block that holds `x` itself.
+ */
+#define GKO_DECLARE_DENSE_COMPUTE_MULTI_CONJ_DOT_KERNEL(_type)               \
+    void compute_multi_conj_dot(std::shared_ptr<const DefaultExecutor> exec, \
+                                const matrix::Dense<_type>* x,               \
+                                const matrix::Dense<_type>* y,               \
+                                matrix::Dense<_type>* result,                \
+                                array<char>& tmp)
+
+
+/**
+ * Computes y = beta * y + alpha * x in a single pass, with the results of
+ * scale(beta, y) followed by add_scaled(alpha, x, y): a zero beta discards the
+ * old values of y, and a zero alpha ignores x. alpha and beta hold either one
+ * value for all columns or one value per column.
+ */
+#define GKO_DECLARE_DENSE_SCALE_ADD_SCALED_KERNEL(_type, _scalar_type) \
+    void scale_add_scaled(std::shared_ptr<const DefaultExecutor> exec, \
+                          const matrix::Dense<_scalar_type>* beta,     \
+                          const matrix::Dense<_scalar_type>* alpha,    \
+                          const matrix::Dense<_type>* x,               \
+                          matrix::Dense<_type>* y)
+
+
+#define GKO_DECLARE_ALL_AS_TEMPLATES                            \
+    template <typename ValueType>                               \
+    GKO_DECLARE_DENSE_COMPUTE_MULTI_CONJ_DOT_KERNEL(ValueType); \
+    template <typename ValueType, typename ScalarType>          \
+    GKO_DECLARE_DENSE_SCALE_ADD_SCALED_KERNEL(ValueType, ScalarType)
+
+
+GKO_DECLARE_FOR_ALL_EXECUTOR_NAMESPACES(dense, GKO_DECLARE_ALL_AS_TEMPLATES);
+
+
+#undef GKO_DECLARE_ALL_AS_TEMPLATES
+
+
+}  // namespace kernels
+}  // namespace gko
+
+#endif  // GKO_CORE_MATRIX_DENSE_FUSED_KERNELS_HPP_
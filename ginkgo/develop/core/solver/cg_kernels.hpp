@@ -0,0 +1,273 @@
+/*******************************<GINKGO LICENSE>******************************
+Copyright (c) 2017-2023, the Ginkgo authors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************<GINKGO LICENSE>*******************************/
+
+#ifndef GKO_CORE_SOLVER_CG_KERNELS_HPP_
+#define GKO_CORE_SOLVER_CG_KERNELS_HPP_
+
+
+#include <memory>
+
+
+#include <ginkgo/core/base/array.hpp>
+#include <ginkgo/core/base/math.hpp>
+#include <ginkgo/core/base/types.hpp>
+#include <ginkgo/core/matrix/dense.hpp>
+#include <ginkgo/core/matrix/diagonal.hpp>
+#include <ginkgo/core/stop/stopping_status.hpp>
+
+
+#include "core/base/kernel_declaration.hpp"
+
+
+namespace gko {
+namespace kernels {
+namespace cg {
+
+
+#define GKO_DECLARE_CG_INITIALIZE_KERNEL(_type)                              \
+    void initialize(std::shared_ptr<const DefaultExecutor> exec,             \
+                    const matrix::Dense<_type>* b, matrix::Dense<_type>* r,  \
+                    matrix::Dense<_type>* z, matrix::Dense<_type>* p,        \
+                    matrix::Dense<_type>* q, matrix::Dense<_type>* prev_rho, \
+                    matrix::Dense<_type>* rho,                               \
+                    array<stopping_status>* stop_status)
+
+
+#define GKO_DECLARE_CG_STEP_1_KERNEL(_type)                             \
+    void step_1(std::shared_ptr<const DefaultExecutor> exec,            \
+                matrix::Dense<_type>* p, const matrix::Dense<_type>* z, \
+                const matrix::Dense<_type>* rho,                        \
+                const matrix::Dense<_type>* prev_rho,                   \
+                const array<stopping_status>* stop_status)
+
+
+#define GKO_DECLARE_CG_STEP_2_KERNEL(_type)                                   \
+    void step_2(std::shared_ptr<const DefaultExecutor> exec,                  \
+                matrix::Dense<_type>* x, matrix::Dense<_type>* r,             \
+                const matrix::Dense<_type>* p, const matrix::Dense<_type>* q, \
+                const matrix::Dense<_type>* beta,                             \
+                const matrix::Dense<_type>* rho,                              \
+                const array<stopping_status>* stop_status)
+
+
+/**
+ * step_2 of the unpreconditioned CG, fused with the dot product for the next
+ * iteration. Updates x and r like step_2, then stores rho in prev_rho and
+ * r^H r in rho for all columns, in a single pass over the vectors.
+ */
+#define GKO_DECLARE_CG_STEP_2_FUSED_KERNEL(_type)                          \
+    void step_2_fused(std::shared_ptr<const DefaultExecutor> exec,         \
+                      matrix::Dense<_type>* x, matrix::Dense<_type>* r,    \
+                      const matrix::Dense<_type>* p,                       \
+                      const matrix::Dense<_type>* q,                       \
+                      const matrix::Dense<_type>* beta,                    \
+                      matrix::Dense<_type>* prev_rho,                      \
+                      matrix::Dense<_type>* rho, array<char>& tmp,         \
+                      const array<stopping_status>* stop_status)
+
+
+/**
+ * step_2 of the CG with a scalar Jacobi preconditioner, fused with the
+ * preconditioner application and the dot product for the next iteration.
+ * Updates x and r like step_2, computes z = inv_diag * r, then stores rho in
+ * prev_rho and r^H z in rho for all columns, in a single pass over the
+ * vectors.
+ */
+#define GKO_DECLARE_CG_STEP_2_JACOBI_KERNEL(_type)                          \
+    void step_2_jacobi(std::shared_ptr<const DefaultExecutor> exec,         \
+                       matrix::Dense<_type>* x, matrix::Dense<_type>* r,    \
+                       matrix::Dense<_type>* z,                             \
+                       const matrix::Dense<_type>* p,                       \
+                       const matrix::Dense<_type>* q,                       \
+                       const matrix::Diagonal<_type>* inv_diag,             \
+                       const matrix::Dense<_type>* beta,                    \
+                       matrix::Dense<_type>* prev_rho,                      \
+                       matrix::Dense<_type>* rho, array<char>& tmp,         \
+                       const array<stopping_status>* stop_status)
+
+
+/**
+ * Initializes the pipelined CG: copies b to r, sets p, q, s and z to zero,
+ * prev_rho to zero, so that the first iteration uses no previous search
+ * direction, alpha to one, and resets the stopping status.
+ */
+#define GKO_DECLARE_CG_INITIALIZE_PIPELINED_KERNEL(_type)            \
+    void initialize_pipelined(                                       \
+        std::shared_ptr<const DefaultExecutor> exec,                 \
+        const matrix::Dense<_type>* b, matrix::Dense<_type>* r,      \
+        matrix::Dense<_type>* p, matrix::Dense<_type>* q,            \
+        matrix::Dense<_type>* s, matrix::Dense<_type>* z,            \
+        matrix::Dense<_type>* prev_rho, matrix::Dense<_type>* alpha, \
+        array<stopping_status>* stop_status)
+
+
+/**
+ * Computes both dot products of an iteration of the pipelined CG in a single
+ * pass over the vectors: dots(0, j) = r_j^H u_j and dots(0, n + j) = w_j^H u_j
+ * for the n columns of r, where u = M r and w = A u.
+ *
+ * Since the results are stored contiguously, a distributed solver can combine
+ * them in one (non-blocking) global reduction, and overlap it with computing
+ * m = M w and n = A m.
+ */
+#define GKO_DECLARE_CG_STEP_1_PIPELINED_KERNEL(_type)                  \
+    void step_1_pipelined(std::shared_ptr<const DefaultExecutor> exec, \
+                          const matrix::Dense<_type>* r,               \
+                          const matrix::Dense<_type>* u,               \
+                          const matrix::Dense<_type>* w,               \
+                          matrix::Dense<_type>* dots, array<char>& tmp)
+
+
+/**
+ * Updates all vectors of the pipelined CG (Ghysels and Vanroose) from the dot
+ * products computed by step_1_pipelined and m = M w, n = A m, in a single pass
+ * over the vectors. For each column that has not stopped,
+ *
+ *     gamma = dots(0, j), delta = dots(0, n + j),
+ *     beta = gamma / prev_rho,
+ *     alpha = gamma / (delta - beta * gamma / alpha),
+ *     z = n + beta * z, q = m + beta * q, s = w + beta * s, p = u + beta * p,
+ *     x = x + alpha * p, r = r - alpha * s, u = u - alpha * q,
+ *     w = w - alpha * z,
+ *
+ * where undefined quotients are zero, and gamma is stored in prev_rho.
+ */
+#define GKO_DECLARE_CG_STEP_2_PIPELINED_KERNEL(_type)                     \
+    void step_2_pipelined(                                                \
+        std::shared_ptr<const DefaultExecutor> exec,                      \
+        matrix::Dense<_type>* x, matrix::Dense<_type>* r,                 \
+        matrix::Dense<_type>* u, matrix::Dense<_type>* w,                 \
+        matrix::Dense<_type>* p, matrix::Dense<_type>* q,                 \
+        matrix::Dense<_type>* s, matrix::Dense<_type>* z,                 \
+        const matrix::Dense<_type>* m, const matrix::Dense<_type>* n,     \
+        const matrix::Dense<_type>* dots, matrix::Dense<_type>* prev_rho, \
+        matrix::Dense<_type>* alpha,                                      \
+        const array<stopping_status>* stop_status)
+
+
+/**
+ * step_1 of the deflated CG (Saad, Yeung, Erhel and Guyomarc'h), which keeps
+ * the search directions A-orthogonal to the k columns of the deflation basis
+ * W. For each column j that has not stopped,
+ *
+ *     p_j = z_j + rho_j / prev_rho_j * p_j - W mu_j,
+ *
+ * where an undefined quotient is zero, and mu = (W^H A W)^{-1} (A W)^H z is
+ * the k x n matrix of projection coefficients computed by the solver.
+ */
+#define GKO_DECLARE_CG_STEP_1_DEFLATED_KERNEL(_type)                  \
+    void step_1_deflated(std::shared_ptr<const DefaultExecutor> exec, \
+                         matrix::Dense<_type>* p,                     \
+                         const matrix::Dense<_type>* z,               \
+                         const matrix::Dense<_type>* basis,           \
+                         const matrix::Dense<_type>* mu,              \
+                         const matrix::Dense<_type>* rho,             \
+                         const matrix::Dense<_type>* prev_rho,        \
+                         const array<stopping_status>* stop_status)
+
+
+/**
+ * step_1 of a CG that stores the search directions p and the preconditioned
+ * residuals z in _storage_type, usually a lower precision than the precision
+ * _type of the coefficients. For each column j that has not stopped,
+ *
+ *     p_j = z_j + rho_j / prev_rho_j * p_j,
+ *
+ * where an undefined quotient is zero. The update is computed in _type and
+ * only rounded to _storage_type when p is stored.
+ */
+#define GKO_DECLARE_CG_STEP_1_MIXED_KERNEL(_storage_type, _type)   \
+    void step_1_mixed(std::shared_ptr<const DefaultExecutor> exec, \
+                      matrix::Dense<_storage_type>* p,             \
+                      const matrix::Dense<_storage_type>* z,       \
+                      const matrix::Dense<_type>* rho,             \
+                      const matrix::Dense<_type>* prev_rho,        \
+                      const array<stopping_status>* stop_status)
+
+
+/**
+ * step_2 of a CG that stores the search directions p and their products q
+ * with the matrix in _storage_type, while the solution x and the residual r
+ * stay in _type. For each column j that has not stopped,
+ *
+ *     x_j += rho_j / beta_j * p_j,    r_j -= rho_j / beta_j * q_j,
+ *
+ * where an undefined quotient is zero, computed in _type.
+ */
+#define GKO_DECLARE_CG_STEP_2_MIXED_KERNEL(_storage_type, _type)        \
+    void step_2_mixed(std::shared_ptr<const DefaultExecutor> exec,      \
+                      matrix::Dense<_type>* x, matrix::Dense<_type>* r, \
+                      const matrix::Dense<_storage_type>* p,            \
+                      const matrix::Dense<_storage_type>* q,            \
+                      const matrix::Dense<_type>* beta,                 \
+                      const matrix::Dense<_type>* rho,                  \
+                      const array<stopping_status>* stop_status)
+
+
+#define GKO_DECLARE_ALL_AS_TEMPLATES                            \
+    template <typename ValueType>                               \
+    GKO_DECLARE_CG_INITIALIZE_KERNEL(ValueType);                \
+    template <typename ValueType>                               \
+    GKO_DECLARE_CG_STEP_1_KERNEL(ValueType);                    \
+    template <typename ValueType>                               \
+    GKO_DECLARE_CG_STEP_2_KERNEL(ValueType);                    \
+    template <typename ValueType>                               \
+    GKO_DECLARE_CG_STEP_2_FUSED_KERNEL(ValueType);              \
+    template <typename ValueType>                               \
+    GKO_DECLARE_CG_STEP_2_JACOBI_KERNEL(ValueType);             \
+    template <typename ValueType>                               \
+    GKO_DECLARE_CG_INITIALIZE_PIPELINED_KERNEL(ValueType);      \
+    template <typename ValueType>                               \
+    GKO_DECLARE_CG_STEP_1_PIPELINED_KERNEL(ValueType);          \
+    template <typename ValueType>                               \
+    GKO_DECLARE_CG_STEP_2_PIPELINED_KERNEL(ValueType);          \
+    template <typename ValueType>                               \
+    GKO_DECLARE_CG_STEP_1_DEFLATED_KERNEL(ValueType);           \
+    template <typename StorageType, typename ValueType>         \
+    GKO_DECLARE_CG_STEP_1_MIXED_KERNEL(StorageType, ValueType); \
+    template <typename StorageType, typename ValueType>         \
+    GKO_DECLARE_CG_STEP_2_MIXED_KERNEL(StorageType, ValueType)
+
+
+}  // namespace cg
+
+
+GKO_DECLARE_FOR_ALL_EXECUTOR_NAMESPACES(cg, GKO_DECLARE_ALL_AS_TEMPLATES);
+
+
+#undef GKO_DECLARE_ALL_AS_TEMPLATES
+
+
+}  // namespace kernels
+}  // namespace gko
+
+#endif  // GKO_CORE_SOLVER_CG_KERNELS_HPP_
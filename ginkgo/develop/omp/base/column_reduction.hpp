@@ -0,0 +1,332 @@
+/*******************************<GINKGO LICENSE>******************************
+Copyright (c) 2017-2023, the Ginkgo authors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************<GINKGO LICENSE>*******************************/
+
+#ifndef GKO_OMP_BASE_COLUMN_REDUCTION_HPP_
+#define GKO_OMP_BASE_COLUMN_REDUCTION_HPP_
+
+
+#include <algorithm>
+#include <cstdint>
+#include <type_traits>
+
+
+#include <omp.h>
+
+
+#include <ginkgo/core/base/array.hpp>
+#include <ginkgo/core/base/math.hpp>
+#include <ginkgo/core/base/types.hpp>
+#include <ginkgo/core/matrix/dense.hpp>
+
+
+#include "omp/base/parallel_team.hpp"
+
+
+namespace gko {
+namespace kernels {
+namespace omp {
+
+
+/**
+ * Number of consecutive rows summed into one partial result by the
+ * reproducible reductions.
+ */
+constexpr size_type reproducible_block_size = 1024;
+
+
+/**
+ * Number of interleaved partial sums within a block of rows, which lets the
+ * compiler vectorize the sum without reordering it.
+ */
+constexpr size_type reproducible_num_lanes = 8;
+
+
+/**
+ * Computes result(0, j) = finalize(sum_i op(i, j)) for all rows i and columns j
+ * of an iteration space of the given size, in an order that only depends on
+ * the size.
+ *
+ * The rows are split into blocks of `reproducible_block_size` rows. Within a
+ * block, row i is added to the partial sum of lane i modulo
+ * `reproducible_num_lanes`, and the lanes are summed in order. The threads
+ * compute the partial sums of the blocks they own according to
+ * get_thread_range and store them in `tmp`. The partial sums of each column
+ * are then added in block order. The results are thus bitwise identical for
+ * any number of threads, at the cost of a sequential final sum over the
+ * blocks of each column.
+ *
+ * @param size  the size of the iteration space
+ * @param result  the row vector of results
+ * @param tmp  the workspace for the partial results, resized if necessary
+ * @param op  the function computing the value added for entry (i, j), called
+ *            exactly once for each entry, so it may also update the entry
+ * @param finalize  the function applied to the sum of each column
+ */
+template <typename ResultType, typename ReductionOp, typename FinalizeOp>
+void reduce_columns_reproducible(dim<2> size,
+                                 matrix::Dense<ResultType>* result,
+                                 array<char>& tmp, ReductionOp op,
+                                 FinalizeOp finalize)
+{
+    const auto num_rows = size[0];
+    const auto num_cols = size[1];
+    const auto num_blocks =
+        static_cast<size_type>(ceildiv(num_rows, reproducible_block_size));
+    run_on_team([&] {
+#pragma omp single
+        {
+            const auto num_bytes = num_blocks * num_cols * sizeof(ResultType);
+            if (tmp.get_num_elems() < num_bytes) {
+                tmp.resize_and_reset(num_bytes);
+            }
+        }
+        const auto partials = reinterpret_cast<ResultType*>(tmp.get_data());
+        const auto blocks = get_thread_range(num_blocks);
+        for (auto block = blocks.begin; block < blocks.end; ++block) {
+            const auto begin = block * reproducible_block_size;
+            const auto end =
+                std::min(begin + reproducible_block_size, num_rows);
+            for (size_type j = 0; j < num_cols; ++j) {
+                ResultType lanes[reproducible_num_lanes]{};
+                for (auto i = begin; i < end; i += reproducible_num_lanes) {
+                    const auto num_lanes =
+                        std::min(reproducible_num_lanes, end - i);
+#pragma omp simd
+                    for (size_type lane = 0; lane < num_lanes; ++lane) {
+                        lanes[lane] += op(i + lane, j);
+                    }
+                }
+                auto val = zero<ResultType>();
+                for (size_type lane = 0; lane < reproducible_num_lanes;
+                     ++lane) {
+                    val += lanes[lane];
+                }
+                partials[j * num_blocks + block] = val;
+            }
+        }
+#pragma omp barrier
+#pragma omp for schedule(static)
+        for (size_type j = 0; j < num_cols; ++j) {
+            auto val = zero<ResultType>();
+            for (size_type block = 0; block < num_blocks; ++block) {
+                val += partials[j * num_blocks + block];
+            }
+            result->at(0, j) = finalize(val);
+        }
+    });
+}
+
+
+/**
+ * Size of the per-thread slots of partial results, in bytes. The slots start
+ * at a multiple of this size in `tmp`, so that two threads never write to the
+ * same cache line.
+ */
+constexpr size_type reduction_slot_alignment = 64;
+
+
+/**
+ * Returns the first address in `tmp` aligned to reduction_slot_alignment.
+ * `tmp` must hold reduction_slot_alignment - 1 bytes more than needed from this
+ * address on.
+ */
+template <typename ResultType>
+ResultType* get_aligned_slots(array<char>& tmp)
+{
+    const auto address = reinterpret_cast<std::uintptr_t>(tmp.get_data());
+    const auto misalignment = address % reduction_slot_alignment;
+    const auto offset =
+        misalignment == 0 ? 0 : reduction_slot_alignment - misalignment;
+    return reinterpret_cast<ResultType*>(tmp.get_data() + offset);
+}
+
+
+/**
+ * Returns the sum of op(i) for begin <= i < end.
+ */
+template <typename ResultType, typename ReductionOp>
+std::enable_if_t<!is_complex_s<ResultType>::value, ResultType> reduce_range(
+    size_type begin, size_type end, ReductionOp op)
+{
+    auto val = zero<ResultType>();
+#pragma omp simd reduction(+ : val)
+    for (auto i = begin; i < end; ++i) {
+        val += op(i);
+    }
+    return val;
+}
+
+
+/**
+ * Returns the sum of op(i) for begin <= i < end. The real and imaginary parts
+ * are summed separately, so the loop vectorizes like a real reduction.
+ */
+template <typename ResultType, typename ReductionOp>
+std::enable_if_t<is_complex_s<ResultType>::value, ResultType> reduce_range(
+    size_type begin, size_type end, ReductionOp op)
+{
+    auto real_val = zero<remove_complex<ResultType>>();
+    auto imag_val = zero<remove_complex<ResultType>>();
+#pragma omp simd reduction(+ : real_val, imag_val)
+    for (auto i = begin; i < end; ++i) {
+        const auto val = op(i);
+        real_val += val.real();
+        imag_val += val.imag();
+    }
+    return {real_val, imag_val};
+}
+
+
+/**
+ * Computes result(0, j) = finalize(sum_i op(i, j)) for all rows i and columns j
+ * of an iteration space of the given size with a two-level reduction.
+ *
+ * Each thread first reduces the rows it owns according to get_thread_range,
+ * going over tiles of rows so that all columns of a tile are reduced while it
+ * is in cache. Its partial results are stored in its own slot of `tmp`. The
+ * columns are then split among the threads, which combine the partial results
+ * of all threads in thread order. Unlike a parallel loop over the columns,
+ * this keeps all threads busy for tall-skinny vectors. The order of the sum
+ * depends on the number of threads.
+ *
+ * @param size  the size of the iteration space
+ * @param row_block_size  the number of rows per tile
+ * @param result  the row vector of results
+ * @param tmp  the workspace for the partial results, resized if necessary
+ * @param op  the function computing the value added for entry (i, j), called
+ *            exactly once for each entry, so it may also update the entry
+ * @param finalize  the function applied to the sum of each column
+ */
+template <typename ResultType, typename ReductionOp, typename FinalizeOp>
+void reduce_columns_fast(dim<2> size, size_type row_block_size,
+                         matrix::Dense<ResultType>* result, array<char>& tmp,
+                         ReductionOp op, FinalizeOp finalize)
+{
+    const auto num_rows = size[0];
+    const auto num_cols = size[1];
+    const auto slot_size =
+        static_cast<size_type>(ceildiv(num_cols * sizeof(ResultType),
+                                       reduction_slot_alignment)) *
+        reduction_slot_alignment / sizeof(ResultType);
+    run_on_team([&] {
+        const auto num_threads = static_cast<size_type>(omp_get_num_threads());
+        const auto thread_id = static_cast<size_type>(omp_get_thread_num());
+#pragma omp single
+        {
+            const auto num_bytes = num_threads * slot_size *
+                                       sizeof(ResultType) +
+                                   reduction_slot_alignment - 1;
+            if (tmp.get_num_elems() < num_bytes) {
+                tmp.resize_and_reset(num_bytes);
+            }
+        }
+        const auto partials = get_aligned_slots<ResultType>(tmp);
+        const auto local = partials + thread_id * slot_size;
+        for (size_type j = 0; j < num_cols; ++j) {
+            local[j] = zero<ResultType>();
+        }
+        const auto rows = get_thread_range(num_rows);
+        for (auto begin = rows.begin; begin < rows.end;
+             begin += row_block_size) {
+            const auto end = std::min(begin + row_block_size, rows.end);
+            for (size_type j = 0; j < num_cols; ++j) {
+                local[j] += reduce_range<ResultType>(
+                    begin, end, [&](size_type i) { return op(i, j); });
+            }
+        }
+#pragma omp barrier
+#pragma omp for schedule(static)
+        for (size_type j = 0; j < num_cols; ++j) {
+            auto val = zero<ResultType>();
+            for (size_type thread = 0; thread < num_threads; ++thread) {
+                val += partials[thread * slot_size + j];
+            }
+            result->at(0, j) = finalize(val);
+        }
+    });
+}
+
+
+/**
+ * Computes result(0, j) = finalize(sum_i op(i, j)) for all rows i and columns j
+ * of an iteration space of the given size, with reduce_columns_reproducible if
+ * GKO_OMP_REPRODUCIBLE_REDUCTIONS is defined, and with reduce_columns_fast
+ * otherwise.
+ *
+ * @param size  the size of the iteration space
+ * @param row_block_size  the number of rows per tile of reduce_columns_fast
+ * @param result  the row vector of results
+ * @param tmp  the workspace for the partial results, resized if necessary
+ * @param op  the function computing the value added for entry (i, j), called
+ *            exactly once for each entry, so it may also update the entry
+ * @param finalize  the function applied to the sum of each column
+ */
+template <typename ResultType, typename ReductionOp, typename FinalizeOp>
+void reduce_columns(dim<2> size, size_type row_block_size,
+                    matrix::Dense<ResultType>* result, array<char>& tmp,
+                    ReductionOp op, FinalizeOp finalize)
+{
+#ifdef GKO_OMP_REPRODUCIBLE_REDUCTIONS
+    reduce_columns_reproducible(size, result, tmp, op, finalize);
+#else
+    reduce_columns_fast(size, row_block_size, result, tmp, op, finalize);
+#endif
+}
+
+
+/**
+ * Computes result(0, j) = finalize(sum_i op(i, j)) for all columns j of `x`,
+ * going over `x` in the tiles of get_row_block_size.
+ *
+ * @param x  the vectors to reduce
+ * @param result  the row vector of results
+ * @param tmp  the workspace for the partial results, resized if necessary
+ * @param op  the function computing the value added for entry (i, j), called
+ *            exactly once for each entry, so it may also update the entry
+ * @param finalize  the function applied to the sum of each column
+ */
+template <typename ValueType, typename ResultType, typename ReductionOp,
+          typename FinalizeOp>
+void reduce_columns(const matrix::Dense<ValueType>* x,
+                    matrix::Dense<ResultType>* result, array<char>& tmp,
+                    ReductionOp op, FinalizeOp finalize)
+{
+    reduce_columns(x->get_size(), get_row_block_size(x), result, tmp, op,
+                   finalize);
+}
+
+
+}  // namespace omp
+}  // namespace kernels
+}  // namespace gko
+
+#endif  // GKO_OMP_BASE_COLUMN_REDUCTION_HPP_
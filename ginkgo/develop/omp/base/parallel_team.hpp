@@ -0,0 +1,300 @@
+/*******************************<GINKGO LICENSE>******************************
+Copyright (c) 2017-2023, the Ginkgo authors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************<GINKGO LICENSE>*******************************/
+
+#ifndef GKO_OMP_BASE_PARALLEL_TEAM_HPP_
+#define GKO_OMP_BASE_PARALLEL_TEAM_HPP_
+
+
+#include <algorithm>
+
+
+#include <omp.h>
+
+
+#include <ginkgo/core/base/math.hpp>
+#include <ginkgo/core/base/range.hpp>
+#include <ginkgo/core/base/types.hpp>
+#include <ginkgo/core/matrix/dense.hpp>
+
+
+namespace gko {
+namespace kernels {
+namespace omp {
+
+
+/**
+ * Returns the rows of a vector with `size` rows owned by the calling thread of
+ * the current team.
+ *
+ * The rows are split into contiguous ranges whose lengths differ by at most
+ * one, in thread order. This is the split `schedule(static)` produces in
+ * libgomp; other runtimes shift the boundaries by fewer than the number of
+ * threads. Kernels iterating over the rows in this way touch each page of a
+ * vector from the same thread, so the pages placed by the first touch in an
+ * initialization kernel stay local to the NUMA node of the threads streaming
+ * them later.
+ *
+ * @param size  the number of rows
+ *
+ * @return the range of rows owned by the calling thread, possibly empty
+ */
+inline span get_thread_range(size_type size)
+{
+    const auto num_threads = static_cast<size_type>(omp_get_num_threads());
+    const auto thread_id = static_cast<size_type>(omp_get_thread_num());
+    const auto chunk = size / num_threads;
+    const auto remainder = size % num_threads;
+    const auto begin = thread_id * chunk + std::min(thread_id, remainder);
+    return span{begin, begin + chunk + (thread_id < remainder ? 1 : 0)};
+}
+
+
+/**
+ * Number of bytes of each vector a tile of rows spans in the kernels going over
+ * the rows of several vectors in tiles.
+ */
+constexpr size_type tile_bytes = 8192;
+
+
+/**
+ * Computes the number of consecutive rows that form one tile of `vec`.
+ *
+ * Kernels processing several columns go over the rows each thread owns
+ * according to get_thread_range in tiles of this many rows, and process all
+ * columns of a tile before moving to the next one, so the tile stays in cache
+ * while its columns are processed.
+ *
+ * @param vec  one of the vectors the kernel goes over
+ *
+ * @return the number of rows per tile, at least 1
+ */
+template <typename ValueType>
+size_type get_row_block_size(const matrix::Dense<ValueType>* vec)
+{
+    return std::max<size_type>(
+        tile_bytes / (std::max<size_type>(vec->get_stride(), 1) *
+                      sizeof(ValueType)),
+        1);
+}
+
+
+/**
+ * Number of tiles each thread gets on average when for_each_tile splits both
+ * the rows and the columns among the threads. A few tiles per thread keep the
+ * load balanced when the number of columns is not a multiple of the number of
+ * threads.
+ */
+constexpr size_type tiles_per_thread = 4;
+
+
+/**
+ * Computes the number of consecutive rows of a single column that form one
+ * tile when the `size` iteration space is split among `num_threads` threads
+ * in both dimensions:
+ * - with few columns, the tiles split the rows across the threads,
+ * - with many columns, a tile covers a whole column and the threads work on
+ *   distinct columns,
+ * - in between, both dimensions are split.
+ *
+ * @param size  the size of the iteration space
+ * @param num_threads  the number of threads of the team
+ *
+ * @return the number of rows per tile, at least 1
+ */
+inline size_type get_row_block_size(dim<2> size, size_type num_threads)
+{
+    const auto num_cols = std::max<size_type>(size[1], 1);
+    const auto num_row_blocks = static_cast<size_type>(
+        ceildiv(num_threads * tiles_per_thread, num_cols));
+    return std::max<size_type>(
+        static_cast<size_type>(ceildiv(size[0], num_row_blocks)), 1);
+}
+
+
+/**
+ * Calls fn(rows, cols) for each tile of a `num_rows` x `num_cols` iteration
+ * space assigned to the calling thread of the current team, where `rows` and
+ * `cols` are the spans the tile covers.
+ *
+ * If every thread gets at least `row_block_size` rows, the rows are split
+ * according to get_thread_range, the split the initialization kernels first
+ * touch the vectors with, and each tile covers `row_block_size` rows of all
+ * columns. Otherwise, e.g. for short vectors with many columns, splitting only
+ * the rows would leave threads idle, so the tiles cover the rows given by
+ * get_row_block_size(dim<2>, size_type) of a single column, and are
+ * distributed with a static schedule. Such vectors span only a few pages per
+ * thread, so their placement matters little.
+ *
+ * Must be called by all threads of the team, and does not end with a
+ * barrier.
+ *
+ * @param num_rows  the number of rows
+ * @param num_cols  the number of columns
+ * @param row_block_size  the number of rows per tile of the row split, see
+ *                        get_row_block_size(const matrix::Dense<ValueType>*)
+ * @param fn  the function processing a tile
+ */
+template <typename TileFunction>
+void for_each_tile(size_type num_rows, size_type num_cols,
+                   size_type row_block_size, TileFunction fn)
+{
+    const auto num_threads = static_cast<size_type>(omp_get_num_threads());
+    if (num_rows >= num_threads * row_block_size) {
+        const auto rows = get_thread_range(num_rows);
+        for (auto begin = rows.begin; begin < rows.end;
+             begin += row_block_size) {
+            fn(span{begin, std::min(begin + row_block_size, rows.end)},
+               span{0, num_cols});
+        }
+        return;
+    }
+    const auto tile_rows = std::min(
+        row_block_size,
+        get_row_block_size(dim<2>{num_rows, num_cols}, num_threads));
+    const auto num_row_blocks =
+        static_cast<size_type>(ceildiv(num_rows, tile_rows));
+#pragma omp for collapse(2) schedule(static) nowait
+    for (size_type block = 0; block < num_row_blocks; ++block) {
+        for (size_type j = 0; j < num_cols; ++j) {
+            const auto begin = block * tile_rows;
+            fn(span{begin, std::min(begin + tile_rows, num_rows)},
+               span{j, j + 1});
+        }
+    }
+}
+
+
+namespace detail {
+
+
+/**
+ * Returns the nesting level of the parallel region whose team the kernels
+ * called by this thread join, or -1 if they open their own regions.
+ */
+inline int& shared_team_level()
+{
+    static thread_local int level = -1;
+    return level;
+}
+
+
+}  // namespace detail
+
+
+/**
+ * Lets the OpenMP kernels join the team of the parallel region the guard is
+ * created in, for the lifetime of the guard.
+ *
+ * This is the execution mode of a solver that opens a single parallel region
+ * over its whole iteration instead of paying a fork and join in every kernel.
+ * Every thread of the team must create its own guard and then call the same
+ * kernels in the same order with the same arguments, like for any orphaned
+ * work-sharing construct. Without a guard, e.g. when an application calls
+ * Ginkgo from several threads of its own parallel region, each kernel keeps
+ * opening its own (nested) parallel region.
+ *
+ * Only the kernels running their work through run_on_team can be called under
+ * a guard:
+ * - the dense copy, fill, scale, inv_scale, add_scaled, sub_scaled and
+ *   scale_add_scaled kernels,
+ * - the dense reductions going through reduce_columns, i.e. compute_dot,
+ *   compute_conj_dot, compute_multi_conj_dot, compute_norm2,
+ *   compute_squared_norm2 and compute_norm1, and their dispatch variants,
+ * - the dense simple_apply and apply, which use the row-wise product instead
+ *   of packed_gemm and split_inner_gemm under a guard, because these allocate
+ *   their workspace before opening their own region,
+ * - all CG kernels.
+ * The remaining kernels open their own parallel region, and must be called
+ * outside of a guard.
+ */
+class team_execution_guard {
+public:
+    team_execution_guard() : previous_level_{detail::shared_team_level()}
+    {
+        detail::shared_team_level() = omp_get_level();
+    }
+
+    team_execution_guard(const team_execution_guard&) = delete;
+
+    team_execution_guard& operator=(const team_execution_guard&) = delete;
+
+    ~team_execution_guard() { detail::shared_team_level() = previous_level_; }
+
+private:
+    int previous_level_;
+};
+
+
+/**
+ * Checks whether the calling thread created a team_execution_guard in the
+ * innermost parallel region it is part of, i.e. whether run_on_team joins the
+ * team of that region.
+ */
+inline bool joins_shared_team()
+{
+    const auto level = omp_get_level();
+    return level > 0 && level == detail::shared_team_level();
+}
+
+
+/**
+ * Runs the work-sharing constructs in `fn` on a thread team.
+ *
+ * When called inside a parallel region in which the calling thread created a
+ * team_execution_guard, `fn` is executed by the calling thread and its
+ * work-sharing constructs are orphaned, i.e. they bind to the team of that
+ * region. Otherwise, a new parallel region is opened to run `fn`.
+ *
+ * `fn` must only use work-sharing constructs with static schedules or
+ * get_thread_range, and must end with a barrier (the implicit one of a
+ * work-sharing construct without `nowait`, or an explicit one), so that each
+ * thread gets the same chunks whenever the iteration space is the same.
+ *
+ * @param fn  the function containing the work-sharing constructs
+ */
+template <typename Function>
+void run_on_team(Function&& fn)
+{
+    if (joins_shared_team()) {
+        fn();
+    } else {
+#pragma omp parallel
+        fn();
+    }
+}
+
+
+}  // namespace omp
+}  // namespace kernels
+}  // namespace gko
+
+#endif  // GKO_OMP_BASE_PARALLEL_TEAM_HPP_
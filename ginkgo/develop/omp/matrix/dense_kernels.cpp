@@ -56,6 +56,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "accessor/range.hpp"
 #include "core/base/mixed_precision_types.hpp"
 #include "core/components/prefix_sum_kernels.hpp"
+#include "core/matrix/dense_fused_kernels.hpp"
+#include "omp/base/column_reduction.hpp"
+#include "omp/base/parallel_team.hpp"
 
 
 namespace gko {
@@ -69,6 +72,298 @@ namespace omp {
 namespace dense {
 
 
+namespace {
+
+
+/**
+ * Blocking parameters of the packed matrix product used by simple_apply and
+ * apply, following the usual layered GEMM design:
+ * - a panel of at most `gemm_kc` x `gemm_nc` values of B is packed once by the
+ *   whole team, to be reused from the shared cache,
+ * - each thread packs blocks of at most `gemm_mc` x `gemm_kc` values of A,
+ *   to be reused from its private cache,
+ * - the micro-kernel keeps a `gemm_mr` x `gemm_nr` tile of C in registers.
+ */
+constexpr size_type gemm_mr = 4;
+constexpr size_type gemm_kc = 256;
+constexpr size_type gemm_mc = 96;
+
+
+/**
+ * Returns the number of columns of the register tile, which spans 64 bytes of
+ * each row of C.
+ */
+template <typename ValueType>
+constexpr size_type gemm_nr()
+{
+    return sizeof(ValueType) < 32 ? 64 / sizeof(ValueType) : 2;
+}
+
+
+template <typename ValueType>
+constexpr size_type gemm_nc()
+{
+    return 128 * gemm_nr<ValueType>();
+}
+
+
+/**
+ * Products with fewer multiply-adds than this use the plain row-wise loop,
+ * for which packing does not pay off.
+ */
+constexpr size_type gemm_min_work = 32 * 32 * 32;
+
+
+/**
+ * Checks whether C += alpha * A * B is large enough to use packed_gemm.
+ */
+template <typename ValueType>
+bool use_packed_gemm(const matrix::Dense<ValueType>* a,
+                     const matrix::Dense<ValueType>* b)
+{
+    const auto num_rows = a->get_size()[0];
+    const auto num_inner = a->get_size()[1];
+    const auto num_cols = b->get_size()[1];
+    return num_rows >= gemm_mr && num_cols >= gemm_nr<ValueType>() &&
+           num_rows * num_inner * num_cols >= gemm_min_work;
+}
+
+
+/**
+ * Packs the `num_rows` x `num_inner` block of A starting at (`row`, `inner`)
+ * into slivers of `gemm_mr` rows, stored column by column. The last sliver is
+ * padded with zeros.
+ */
+template <typename ValueType>
+void pack_a_block(const matrix::Dense<ValueType>* a, size_type row,
+                  size_type inner, size_type num_rows, size_type num_inner,
+                  ValueType* a_pack)
+{
+    for (size_type sliver = 0; sliver < num_rows; sliver += gemm_mr) {
+        const auto sliver_rows = std::min(gemm_mr, num_rows - sliver);
+        for (size_type k = 0; k < num_inner; ++k) {
+            for (size_type i = 0; i < sliver_rows; ++i) {
+                a_pack[k * gemm_mr + i] = a->at(row + sliver + i, inner + k);
+            }
+            for (size_type i = sliver_rows; i < gemm_mr; ++i) {
+                a_pack[k * gemm_mr + i] = zero<ValueType>();
+            }
+        }
+        a_pack += num_inner * gemm_mr;
+    }
+}
+
+
+/**
+ * Packs the sliver of `gemm_nr` columns of B starting at (`inner`, `col`)
+ * and spanning `num_inner` rows, stored row by row. Columns beyond
+ * `num_cols` are padded with zeros.
+ */
+template <typename ValueType>
+void pack_b_sliver(const matrix::Dense<ValueType>* b, size_type inner,
+                   size_type col, size_type num_inner, size_type num_cols,
+                   ValueType* b_pack)
+{
+    constexpr auto nr = gemm_nr<ValueType>();
+    const auto sliver_cols = std::min(nr, num_cols - col);
+    for (size_type k = 0; k < num_inner; ++k) {
+        for (size_type j = 0; j < sliver_cols; ++j) {
+            b_pack[k * nr + j] = b->at(inner + k, col + j);
+        }
+        for (size_type j = sliver_cols; j < nr; ++j) {
+            b_pack[k * nr + j] = zero<ValueType>();
+        }
+    }
+}
+
+
+/**
+ * Computes C(row:row+num_rows, col:col+num_cols) += alpha * A_sliver *
+ * B_sliver for packed slivers of A and B, accumulating the full `gemm_mr` x
+ * `gemm_nr` tile in registers.
+ */
+template <typename ValueType>
+void gemm_micro_kernel(size_type num_inner, const ValueType* a_pack,
+                       const ValueType* b_pack, ValueType alpha,
+                       matrix::Dense<ValueType>* c, size_type row,
+                       size_type col, size_type num_rows, size_type num_cols)
+{
+    constexpr auto nr = gemm_nr<ValueType>();
+    ValueType acc[gemm_mr][nr]{};
+    for (size_type k = 0; k < num_inner; ++k) {
+        for (size_type i = 0; i < gemm_mr; ++i) {
+            const auto a_val = a_pack[k * gemm_mr + i];
+#pragma omp simd
+            for (size_type j = 0; j < nr; ++j) {
+                acc[i][j] += a_val * b_pack[k * nr + j];
+            }
+        }
+    }
+    for (size_type i = 0; i < num_rows; ++i) {
+#pragma omp simd
+        for (size_type j = 0; j < num_cols; ++j) {
+            c->at(row + i, col + j) += alpha * acc[i][j];
+        }
+    }
+}
+
+
+/**
+ * Computes C += alpha * A * B with a cache-blocked, packed product.
+ *
+ * The team packs each panel of B together, then the threads share the row
+ * blocks of C, pack their block of A and sweep the register tiles of the
+ * block with gemm_micro_kernel.
+ */
+template <typename ValueType>
+void packed_gemm(std::shared_ptr<const DefaultExecutor> exec,
+                 ValueType alpha, const matrix::Dense<ValueType>* a,
+                 const matrix::Dense<ValueType>* b,
+                 matrix::Dense<ValueType>* c)
+{
+    constexpr auto nr = gemm_nr<ValueType>();
+    constexpr auto nc = gemm_nc<ValueType>();
+    const auto num_rows = c->get_size()[0];
+    const auto num_cols = c->get_size()[1];
+    const auto num_inner = a->get_size()[1];
+    const auto num_threads = static_cast<size_type>(omp_get_max_threads());
+    // shrink the row blocks so that every thread gets at least one
+    const auto rows_per_thread = static_cast<size_type>(
+        ceildiv(num_rows, num_threads * gemm_mr) * gemm_mr);
+    const auto mc = std::min(gemm_mc, rows_per_thread);
+    const auto num_row_blocks =
+        static_cast<size_type>(ceildiv(num_rows, mc));
+    const auto max_inner = std::min(gemm_kc, num_inner);
+    const auto max_cols = std::min(
+        nc, static_cast<size_type>(ceildiv(num_cols, nr) * nr));
+    array<ValueType> b_pack_array{exec, max_inner * max_cols};
+    array<ValueType> a_pack_array{exec, num_threads * mc * max_inner};
+    const auto b_pack = b_pack_array.get_data();
+#pragma omp parallel num_threads(num_threads)
+    {
+        const auto a_pack = a_pack_array.get_data() +
+                            omp_get_thread_num() * mc * max_inner;
+        for (size_type col = 0; col < num_cols; col += nc) {
+            const auto block_cols = std::min(nc, num_cols - col);
+            const auto num_slivers =
+                static_cast<size_type>(ceildiv(block_cols, nr));
+            for (size_type inner = 0; inner < num_inner; inner += gemm_kc) {
+                const auto block_inner = std::min(gemm_kc, num_inner - inner);
+#pragma omp for schedule(static)
+                for (size_type sliver = 0; sliver < num_slivers; ++sliver) {
+                    pack_b_sliver(b, inner, col + sliver * nr, block_inner,
+                                  num_cols, b_pack + sliver * block_inner * nr);
+                }
+#pragma omp for schedule(static)
+                for (size_type block = 0; block < num_row_blocks; ++block) {
+                    const auto row = block * mc;
+                    const auto block_rows = std::min(mc, num_rows - row);
+                    pack_a_block(a, row, inner, block_rows, block_inner,
+                                 a_pack);
+                    for (size_type sliver = 0; sliver < num_slivers;
+                         ++sliver) {
+                        const auto sliver_col = sliver * nr;
+                        const auto sliver_cols =
+                            std::min(nr, block_cols - sliver_col);
+                        for (size_type i = 0; i < block_rows; i += gemm_mr) {
+                            gemm_micro_kernel(
+                                block_inner, a_pack + i * block_inner,
+                                b_pack + sliver * block_inner * nr, alpha, c,
+                                row + i, col + sliver_col,
+                                std::min(gemm_mr, block_rows - i),
+                                sliver_cols);
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+
+/**
+ * Products with at most this many entries in C split the inner dimension
+ * among the threads if it is long enough, see split_inner_gemm.
+ */
+constexpr size_type gemm_split_max_outputs = 1024;
+
+
+/**
+ * Checks whether C += alpha * A * B should use split_inner_gemm, i.e. whether
+ * C is small and each thread gets at least `gemm_kc` values of the inner
+ * dimension.
+ */
+template <typename ValueType>
+bool use_split_inner_gemm(const matrix::Dense<ValueType>* a,
+                          const matrix::Dense<ValueType>* b)
+{
+    const auto num_threads = static_cast<size_type>(omp_get_max_threads());
+    return a->get_size()[0] * b->get_size()[1] <= gemm_split_max_outputs &&
+           a->get_size()[1] >= num_threads * gemm_kc;
+}
+
+
+/**
+ * Computes C += alpha * A * B for a small C and a long inner dimension, like
+ * the Gram matrix of a few tall vectors.
+ *
+ * Splitting the rows or columns of C among the threads would leave most of
+ * them idle, so each thread computes the product over its range of the inner
+ * dimension instead. The partial products are stored in separate slots of a
+ * workspace and added to C in thread order.
+ */
+template <typename ValueType>
+void split_inner_gemm(std::shared_ptr<const DefaultExecutor> exec,
+                      ValueType alpha, const matrix::Dense<ValueType>* a,
+                      const matrix::Dense<ValueType>* b,
+                      matrix::Dense<ValueType>* c)
+{
+    const auto num_rows = c->get_size()[0];
+    const auto num_cols = c->get_size()[1];
+    const auto num_outputs = num_rows * num_cols;
+    // the slots start at multiples of reduction_slot_alignment bytes in the
+    // over-allocated workspace, so they do not share any cache line
+    const auto slot_size =
+        static_cast<size_type>(ceildiv(num_outputs * sizeof(ValueType),
+                                       reduction_slot_alignment)) *
+        reduction_slot_alignment / sizeof(ValueType);
+    const auto num_threads = static_cast<size_type>(omp_get_max_threads());
+    const auto num_bytes = num_threads * slot_size * sizeof(ValueType) +
+                           reduction_slot_alignment - 1;
+    array<char> workspace{exec, num_bytes};
+    const auto partials = get_aligned_slots<ValueType>(workspace);
+#pragma omp parallel num_threads(num_threads)
+    {
+        const auto team_size = static_cast<size_type>(omp_get_num_threads());
+        const auto local = partials + omp_get_thread_num() * slot_size;
+        std::fill_n(local, num_outputs, zero<ValueType>());
+        const auto inner_range = get_thread_range(a->get_size()[1]);
+        for (auto inner = inner_range.begin; inner < inner_range.end;
+             ++inner) {
+            for (size_type row = 0; row < num_rows; ++row) {
+                const auto a_val = a->at(row, inner);
+#pragma omp simd
+                for (size_type col = 0; col < num_cols; ++col) {
+                    local[row * num_cols + col] += a_val * b->at(inner, col);
+                }
+            }
+        }
+#pragma omp barrier
+#pragma omp for schedule(static)
+        for (size_type out = 0; out < num_outputs; ++out) {
+            auto sum = zero<ValueType>();
+            for (size_type thread = 0; thread < team_size; ++thread) {
+                sum += partials[thread * slot_size + out];
+            }
+            c->at(out / num_cols, out % num_cols) += alpha * sum;
+        }
+    }
+}
+
+
+}  // namespace
+
+
 template <typename ValueType>
 void simple_apply(std::shared_ptr<const DefaultExecutor> exec,
                   const matrix::Dense<ValueType>* a,
@@ -77,25 +372,39 @@ void simple_apply(std::shared_ptr<const DefaultExecutor> exec,
 {
     fill(exec, c, zero<ValueType>());
 
-#pragma omp parallel for
-    for (size_type row = 0; row < c->get_size()[0]; ++row) {
-        for (size_type inner = 0; inner < a->get_size()[1]; ++inner) {
-            const auto a_val = a->at(row, inner);
-            if (is_nonzero(a_val)) {
-                if (a_val != one<ValueType>()) {
+    // see team_execution_guard for why a shared team uses the row-wise loop
+    if (!joins_shared_team() && use_split_inner_gemm(a, b)) {
+        split_inner_gemm(exec, one<ValueType>(), a, b, c);
+        return;
+    }
+    if (!joins_shared_team() && use_packed_gemm(a, b)) {
+        packed_gemm(exec, one<ValueType>(), a, b, c);
+        return;
+    }
+
+    run_on_team([&] {
+#pragma omp for schedule(static)
+        for (size_type row = 0; row < c->get_size()[0]; ++row) {
+            for (size_type inner = 0; inner < a->get_size()[1]; ++inner) {
+                const auto a_val = a->at(row, inner);
+                if (is_nonzero(a_val)) {
+                    if (a_val != one<ValueType>()) {
 #pragma omp simd
-                    for (size_type col = 0; col < c->get_size()[1]; ++col) {
-                        c->at(row, col) += a_val * b->at(inner, col);
-                    }
-                } else {
+                        for (size_type col = 0; col < c->get_size()[1];
+                             ++col) {
+                            c->at(row, col) += a_val * b->at(inner, col);
+                        }
+                    } else {
 #pragma omp simd
-                    for (size_type col = 0; col < c->get_size()[1]; ++col) {
-                        c->at(row, col) += b->at(inner, col);
+                        for (size_type col = 0; col < c->get_size()[1];
+                             ++col) {
+                            c->at(row, col) += b->at(inner, col);
+                        }
                     }
                 }
             }
         }
-    }
+    });
 }
 
 GKO_INSTANTIATE_FOR_EACH_VALUE_TYPE(GKO_DECLARE_DENSE_SIMPLE_APPLY_KERNEL);
@@ -111,25 +420,39 @@ void apply(std::shared_ptr<const DefaultExecutor> exec,
     const auto vbeta = beta->at(0, 0);
     if (is_nonzero(vbeta)) {
         if (vbeta != one<ValueType>()) {
-#pragma omp parallel for
-            for (size_type row = 0; row < c->get_size()[0]; ++row) {
+            run_on_team([&] {
+#pragma omp for schedule(static)
+                for (size_type row = 0; row < c->get_size()[0]; ++row) {
 #pragma omp simd
-                for (size_type col = 0; col < c->get_size()[1]; ++col) {
-                    c->at(row, col) *= vbeta;
+                    for (size_type col = 0; col < c->get_size()[1]; ++col) {
+                        c->at(row, col) *= vbeta;
+                    }
                 }
-            }
+            });
         }
     } else {
         fill(exec, c, zero<ValueType>());
     }
 
-    if (is_nonzero(valpha)) {
-        if (valpha != one<ValueType>()) {
-#pragma omp parallel for
-            for (size_type row = 0; row < c->get_size()[0]; ++row) {
-                for (size_type inner = 0; inner < a->get_size()[1]; ++inner) {
-                    const auto a_val = a->at(row, inner);
-                    if (is_nonzero(a_val)) {
+    if (is_zero(valpha)) {
+        return;
+    }
+    // see team_execution_guard for why a shared team uses the row-wise loop
+    if (!joins_shared_team() && use_split_inner_gemm(a, b)) {
+        split_inner_gemm(exec, valpha, a, b, c);
+        return;
+    }
+    if (!joins_shared_team() && use_packed_gemm(a, b)) {
+        packed_gemm(exec, valpha, a, b, c);
+        return;
+    }
+    run_on_team([&] {
+#pragma omp for schedule(static)
+        for (size_type row = 0; row < c->get_size()[0]; ++row) {
+            for (size_type inner = 0; inner < a->get_size()[1]; ++inner) {
+                const auto a_val = a->at(row, inner);
+                if (is_nonzero(a_val)) {
+                    if (valpha != one<ValueType>()) {
                         if (a_val != one<ValueType>()) {
 #pragma omp simd
                             for (size_type col = 0; col < c->get_size()[1];
@@ -144,51 +467,129 @@ void apply(std::shared_ptr<const DefaultExecutor> exec,
                                 c->at(row, col) += valpha * b->at(inner, col);
                             }
                         }
-                    }
-                }
-            }
-        } else {
-#pragma omp parallel for
-            for (size_type row = 0; row < c->get_size()[0]; ++row) {
-                for (size_type inner = 0; inner < a->get_size()[1]; ++inner) {
-                    const auto a_val = a->at(row, inner);
-                    if (is_nonzero(a_val)) {
-                        if (a_val != one<ValueType>()) {
+                    } else if (a_val != one<ValueType>()) {
 #pragma omp simd
-                            for (size_type col = 0; col < c->get_size()[1];
-                                 ++col) {
-                                c->at(row, col) += a_val * b->at(inner, col);
-                            }
-                        } else {
+                        for (size_type col = 0; col < c->get_size()[1];
+                             ++col) {
+                            c->at(row, col) += a_val * b->at(inner, col);
+                        }
+                    } else {
 #pragma omp simd
-                            for (size_type col = 0; col < c->get_size()[1];
-                                 ++col) {
-                                c->at(row, col) += b->at(inner, col);
-                            }
+                        for (size_type col = 0; col < c->get_size()[1];
+                             ++col) {
+                            c->at(row, col) += b->at(inner, col);
                         }
                     }
                 }
             }
         }
-    }
+    });
 }
 
 GKO_INSTANTIATE_FOR_EACH_VALUE_TYPE(GKO_DECLARE_DENSE_APPLY_KERNEL);
 
 
+namespace {
+
+
+/**
+ * Checks whether the rows of `mat` are stored without padding, so its values
+ * can be processed as a single array of length rows * cols.
+ */
+template <typename ValueType>
+bool is_contiguous(const matrix::Dense<ValueType>* mat)
+{
+    return mat->get_stride() == mat->get_size()[1];
+}
+
+
+/**
+ * Sets out[i] = op(out[i]) for all i < size.
+ */
+template <typename ValueType, typename UpdateOp>
+void update_contiguous(size_type size, ValueType* out, UpdateOp op)
+{
+#pragma omp simd
+    for (size_type i = 0; i < size; ++i) {
+        out[i] = op(out[i]);
+    }
+}
+
+
+/**
+ * Sets out[i] = op(in[i], out[i]) for all i < size.
+ */
+template <typename InValueType, typename OutValueType, typename CombineOp>
+void combine_contiguous(size_type size, const InValueType* in,
+                        OutValueType* out, CombineOp op)
+{
+#pragma omp simd
+    for (size_type i = 0; i < size; ++i) {
+        out[i] = op(in[i], out[i]);
+    }
+}
+
+
+/**
+ * Applies update_contiguous to the values of the contiguous matrix `mat`. Each
+ * thread of the team processes the range given by get_thread_range.
+ */
+template <typename ValueType, typename UpdateOp>
+void update_dense(matrix::Dense<ValueType>* mat, UpdateOp op)
+{
+    const auto size = mat->get_size()[0] * mat->get_size()[1];
+    run_on_team([&] {
+        const auto range = get_thread_range(size);
+        update_contiguous(range.end - range.begin,
+                          mat->get_values() + range.begin, op);
+#pragma omp barrier
+    });
+}
+
+
+/**
+ * Applies combine_contiguous to the values of the contiguous matrices `in`
+ * and `out`, which have the same size.
+ */
+template <typename InValueType, typename OutValueType, typename CombineOp>
+void combine_dense(const matrix::Dense<InValueType>* in,
+                   matrix::Dense<OutValueType>* out, CombineOp op)
+{
+    const auto size = in->get_size()[0] * in->get_size()[1];
+    run_on_team([&] {
+        const auto range = get_thread_range(size);
+        combine_contiguous(range.end - range.begin,
+                           in->get_const_values() + range.begin,
+                           out->get_values() + range.begin, op);
+#pragma omp barrier
+    });
+}
+
+
+}  // namespace
+
+
 template <typename InValueType, typename OutValueType>
 void copy(std::shared_ptr<const DefaultExecutor> exec,
           const matrix::Dense<InValueType>* input,
           matrix::Dense<OutValueType>* output)
 {
-#pragma omp parallel for
-    for (size_type row = 0; row < input->get_size()[0]; ++row) {
+    if (is_contiguous(input) && is_contiguous(output)) {
+        combine_dense(input, output, [](InValueType in, OutValueType) {
+            return static_cast<OutValueType>(in);
+        });
+        return;
+    }
+    run_on_team([&] {
+#pragma omp for schedule(static)
+        for (size_type row = 0; row < input->get_size()[0]; ++row) {
 #pragma omp simd
-        for (size_type col = 0; col < input->get_size()[1]; ++col) {
-            output->at(row, col) =
-                static_cast<OutValueType>(input->at(row, col));
+            for (size_type col = 0; col < input->get_size()[1]; ++col) {
+                output->at(row, col) =
+                    static_cast<OutValueType>(input->at(row, col));
+            }
         }
-    }
+    });
 }
 
 GKO_INSTANTIATE_FOR_EACH_VALUE_CONVERSION_OR_COPY(
@@ -199,13 +600,19 @@ template <typename ValueType>
 void fill(std::shared_ptr<const DefaultExecutor> exec,
           matrix::Dense<ValueType>* mat, ValueType value)
 {
-#pragma omp parallel for
-    for (size_type row = 0; row < mat->get_size()[0]; ++row) {
+    if (is_contiguous(mat)) {
+        update_dense(mat, [value](ValueType) { return value; });
+        return;
+    }
+    run_on_team([&] {
+#pragma omp for schedule(static)
+        for (size_type row = 0; row < mat->get_size()[0]; ++row) {
 #pragma omp simd
-        for (size_type col = 0; col < mat->get_size()[1]; ++col) {
-            mat->at(row, col) = value;
+            for (size_type col = 0; col < mat->get_size()[1]; ++col) {
+                mat->at(row, col) = value;
+            }
         }
-    }
+    });
 }
 
 GKO_INSTANTIATE_FOR_EACH_VALUE_TYPE(GKO_DECLARE_DENSE_FILL_KERNEL);
@@ -219,35 +626,45 @@ void scale(std::shared_ptr<const DefaultExecutor> exec,
         const auto valpha = alpha->at(0, 0);
         if (is_nonzero(valpha)) {
             if (valpha != one<ValueType>()) {
-#pragma omp parallel for
-                for (size_type i = 0; i < x->get_size()[0]; ++i) {
+                if (is_contiguous(x)) {
+                    update_dense(x, [valpha](ValueType value) {
+                        return value *= valpha;
+                    });
+                } else {
+                    run_on_team([&] {
+#pragma omp for schedule(static)
+                        for (size_type i = 0; i < x->get_size()[0]; ++i) {
 #pragma omp simd
-                    for (size_type j = 0; j < x->get_size()[1]; ++j) {
-                        x->at(i, j) *= valpha;
-                    }
+                            for (size_type j = 0; j < x->get_size()[1]; ++j) {
+                                x->at(i, j) *= valpha;
+                            }
+                        }
+                    });
                 }
             }
         } else {
             fill(exec, x, zero<ValueType>());
         }
     } else {
-#pragma omp parallel for
-        for (size_type j = 0; j < x->get_size()[1]; ++j) {
-            const auto valpha = alpha->at(0, j);
-            if (is_nonzero(valpha)) {
-                if (valpha != one<ValueType>()) {
+        run_on_team([&] {
+#pragma omp for schedule(static)
+            for (size_type j = 0; j < x->get_size()[1]; ++j) {
+                const auto valpha = alpha->at(0, j);
+                if (is_nonzero(valpha)) {
+                    if (valpha != one<ValueType>()) {
 #pragma omp simd
-                    for (size_type i = 0; i < x->get_size()[0]; ++i) {
-                        x->at(i, j) *= valpha;
+                        for (size_type i = 0; i < x->get_size()[0]; ++i) {
+                            x->at(i, j) *= valpha;
+                        }
                     }
-                }
-            } else {
+                } else {
 #pragma omp simd
-                for (size_type i = 0; i < x->get_size()[0]; ++i) {
-                    x->at(i, j) = zero<ValueType>();
+                    for (size_type i = 0; i < x->get_size()[0]; ++i) {
+                        x->at(i, j) = zero<ValueType>();
+                    }
                 }
             }
-        }
+        });
     }
 }
 
@@ -263,35 +680,45 @@ void inv_scale(std::shared_ptr<const DefaultExecutor> exec,
         const auto valpha = alpha->at(0, 0);
         if (is_nonzero(valpha)) {
             if (valpha != one<ValueType>()) {
-#pragma omp parallel for
-                for (size_type i = 0; i < x->get_size()[0]; ++i) {
+                if (is_contiguous(x)) {
+                    update_dense(x, [valpha](ValueType value) {
+                        return value /= valpha;
+                    });
+                } else {
+                    run_on_team([&] {
+#pragma omp for schedule(static)
+                        for (size_type i = 0; i < x->get_size()[0]; ++i) {
 #pragma omp simd
-                    for (size_type j = 0; j < x->get_size()[1]; ++j) {
-                        x->at(i, j) /= valpha;
-                    }
+                            for (size_type j = 0; j < x->get_size()[1]; ++j) {
+                                x->at(i, j) /= valpha;
+                            }
+                        }
+                    });
                 }
             }
         } else {
             fill(exec, x, zero<ValueType>());
         }
     } else {
-#pragma omp parallel for
-        for (size_type j = 0; j < x->get_size()[1]; ++j) {
-            const auto valpha = alpha->at(0, j);
-            if (is_nonzero(valpha)) {
-                if (valpha != one<ValueType>()) {
+        run_on_team([&] {
+#pragma omp for schedule(static)
+            for (size_type j = 0; j < x->get_size()[1]; ++j) {
+                const auto valpha = alpha->at(0, j);
+                if (is_nonzero(valpha)) {
+                    if (valpha != one<ValueType>()) {
 #pragma omp simd
-                    for (size_type i = 0; i < x->get_size()[0]; ++i) {
-                        x->at(i, j) /= valpha;
+                        for (size_type i = 0; i < x->get_size()[0]; ++i) {
+                            x->at(i, j) /= valpha;
+                        }
                     }
-                }
-            } else {
+                } else {
 #pragma omp simd
-                for (size_type i = 0; i < x->get_size()[0]; ++i) {
-                    x->at(i, j) = zero<ValueType>();
+                    for (size_type i = 0; i < x->get_size()[0]; ++i) {
+                        x->at(i, j) = zero<ValueType>();
+                    }
                 }
             }
-        }
+        });
     }
 }
 
@@ -307,42 +734,58 @@ void add_scaled(std::shared_ptr<const DefaultExecutor> exec,
     if (alpha->get_size()[1] == 1) {
         const auto valpha = alpha->at(0, 0);
         if (is_nonzero(valpha)) {
-            if (valpha != one<ValueType>()) {
-#pragma omp parallel for
-                for (size_type i = 0; i < x->get_size()[0]; ++i) {
+            if (is_contiguous(x) && is_contiguous(y)) {
+                if (valpha != one<ValueType>()) {
+                    combine_dense(x, y, [valpha](ValueType xv, ValueType yv) {
+                        return yv += valpha * xv;
+                    });
+                } else {
+                    combine_dense(x, y, [](ValueType xv, ValueType yv) {
+                        return yv += xv;
+                    });
+                }
+            } else if (valpha != one<ValueType>()) {
+                run_on_team([&] {
+#pragma omp for schedule(static)
+                    for (size_type i = 0; i < x->get_size()[0]; ++i) {
 #pragma omp simd
-                    for (size_type j = 0; j < x->get_size()[1]; ++j) {
-                        y->at(i, j) += valpha * x->at(i, j);
+                        for (size_type j = 0; j < x->get_size()[1]; ++j) {
+                            y->at(i, j) += valpha * x->at(i, j);
+                        }
                     }
-                }
+                });
             } else {
-#pragma omp parallel for
-                for (size_type i = 0; i < x->get_size()[0]; ++i) {
+                run_on_team([&] {
+#pragma omp for schedule(static)
+                    for (size_type i = 0; i < x->get_size()[0]; ++i) {
 #pragma omp simd
-                    for (size_type j = 0; j < x->get_size()[1]; ++j) {
-                        y->at(i, j) += x->at(i, j);
+                        for (size_type j = 0; j < x->get_size()[1]; ++j) {
+                            y->at(i, j) += x->at(i, j);
+                        }
                     }
-                }
+                });
             }
         }
     } else {
-#pragma omp parallel for
-        for (size_type j = 0; j < x->get_size()[1]; ++j) {
-            const auto valpha = alpha->at(0, j);
-            if (is_nonzero(valpha)) {
-                if (valpha != one<ValueType>()) {
+        run_on_team([&] {
+#pragma omp for schedule(static)
+            for (size_type j = 0; j < x->get_size()[1]; ++j) {
+                const auto valpha = alpha->at(0, j);
+                if (is_nonzero(valpha)) {
+                    if (valpha != one<ValueType>()) {
 #pragma omp simd
-                    for (size_type i = 0; i < x->get_size()[0]; ++i) {
-                        y->at(i, j) += valpha * x->at(i, j);
-                    }
-                } else {
+                        for (size_type i = 0; i < x->get_size()[0]; ++i) {
+                            y->at(i, j) += valpha * x->at(i, j);
+                        }
+                    } else {
 #pragma omp simd
-                    for (size_type i = 0; i < x->get_size()[0]; ++i) {
-                        y->at(i, j) += x->at(i, j);
+                        for (size_type i = 0; i < x->get_size()[0]; ++i) {
+                            y->at(i, j) += x->at(i, j);
+                        }
                     }
                 }
             }
-        }
+        });
     }
 }
 
@@ -350,6 +793,59 @@ GKO_INSTANTIATE_FOR_EACH_VALUE_AND_SCALAR_TYPE(
     GKO_DECLARE_DENSE_ADD_SCALED_KERNEL);
 
 
+namespace {
+
+
+/**
+ * Returns beta * y + alpha * x, rounded like scale followed by add_scaled.
+ */
+template <typename ValueType, typename ScalarType>
+ValueType scale_add_scaled_value(ScalarType beta, ScalarType alpha,
+                                 ValueType x, ValueType y)
+{
+    const auto scaled = is_nonzero(beta) ? y * beta : zero<ValueType>();
+    return is_nonzero(alpha) ? scaled + alpha * x : scaled;
+}
+
+
+}  // namespace
+
+
+template <typename ValueType, typename ScalarType>
+void scale_add_scaled(std::shared_ptr<const DefaultExecutor> exec,
+                      const matrix::Dense<ScalarType>* beta,
+                      const matrix::Dense<ScalarType>* alpha,
+                      const matrix::Dense<ValueType>* x,
+                      matrix::Dense<ValueType>* y)
+{
+    if (beta->get_size()[1] == 1 && alpha->get_size()[1] == 1 &&
+        is_contiguous(x) && is_contiguous(y)) {
+        const auto vbeta = beta->at(0, 0);
+        const auto valpha = alpha->at(0, 0);
+        combine_dense(x, y, [vbeta, valpha](ValueType xv, ValueType yv) {
+            return scale_add_scaled_value(vbeta, valpha, xv, yv);
+        });
+        return;
+    }
+    const size_type beta_step = beta->get_size()[1] == 1 ? 0 : 1;
+    const size_type alpha_step = alpha->get_size()[1] == 1 ? 0 : 1;
+    run_on_team([&] {
+#pragma omp for schedule(static)
+        for (size_type i = 0; i < x->get_size()[0]; ++i) {
+#pragma omp simd
+            for (size_type j = 0; j < x->get_size()[1]; ++j) {
+                y->at(i, j) = scale_add_scaled_value(
+                    beta->at(0, j * beta_step), alpha->at(0, j * alpha_step),
+                    x->at(i, j), y->at(i, j));
+            }
+        }
+    });
+}
+
+GKO_INSTANTIATE_FOR_EACH_VALUE_AND_SCALAR_TYPE(
+    GKO_DECLARE_DENSE_SCALE_ADD_SCALED_KERNEL);
+
+
 template <typename ValueType, typename ScalarType>
 void sub_scaled(std::shared_ptr<const DefaultExecutor> exec,
                 const matrix::Dense<ScalarType>* alpha,
@@ -358,42 +854,58 @@ void sub_scaled(std::shared_ptr<const DefaultExecutor> exec,
     if (alpha->get_size()[1] == 1) {
         const auto valpha = alpha->at(0, 0);
         if (is_nonzero(valpha)) {
-            if (valpha != one<ValueType>()) {
-#pragma omp parallel for
-                for (size_type i = 0; i < x->get_size()[0]; ++i) {
+            if (is_contiguous(x) && is_contiguous(y)) {
+                if (valpha != one<ValueType>()) {
+                    combine_dense(x, y, [valpha](ValueType xv, ValueType yv) {
+                        return yv -= valpha * xv;
+                    });
+                } else {
+                    combine_dense(x, y, [](ValueType xv, ValueType yv) {
+                        return yv -= xv;
+                    });
+                }
+            } else if (valpha != one<ValueType>()) {
+                run_on_team([&] {
+#pragma omp for schedule(static)
+                    for (size_type i = 0; i < x->get_size()[0]; ++i) {
 #pragma omp simd
-                    for (size_type j = 0; j < x->get_size()[1]; ++j) {
-                        y->at(i, j) -= valpha * x->at(i, j);
+                        for (size_type j = 0; j < x->get_size()[1]; ++j) {
+                            y->at(i, j) -= valpha * x->at(i, j);
+                        }
                     }
-                }
+                });
             } else {
-#pragma omp parallel for
-                for (size_type i = 0; i < x->get_size()[0]; ++i) {
+                run_on_team([&] {
+#pragma omp for schedule(static)
+                    for (size_type i = 0; i < x->get_size()[0]; ++i) {
 #pragma omp simd
-                    for (size_type j = 0; j < x->get_size()[1]; ++j) {
-                        y->at(i, j) -= x->at(i, j);
+                        for (size_type j = 0; j < x->get_size()[1]; ++j) {
+                            y->at(i, j) -= x->at(i, j);
+                        }
                     }
-                }
+                });
             }
         }
     } else {
-#pragma omp parallel for
-        for (size_type j = 0; j < x->get_size()[1]; ++j) {
-            const auto valpha = alpha->at(0, j);
-            if (is_nonzero(valpha)) {
-                if (valpha != one<ValueType>()) {
+        run_on_team([&] {
+#pragma omp for schedule(static)
+            for (size_type j = 0; j < x->get_size()[1]; ++j) {
+                const auto valpha = alpha->at(0, j);
+                if (is_nonzero(valpha)) {
+                    if (valpha != one<ValueType>()) {
 #pragma omp simd
-                    for (size_type i = 0; i < x->get_size()[0]; ++i) {
-                        y->at(i, j) -= valpha * x->at(i, j);
-                    }
-                } else {
+                        for (size_type i = 0; i < x->get_size()[0]; ++i) {
+                            y->at(i, j) -= valpha * x->at(i, j);
+                        }
+                    } else {
 #pragma omp simd
-                    for (size_type i = 0; i < x->get_size()[0]; ++i) {
-                        y->at(i, j) -= x->at(i, j);
+                        for (size_type i = 0; i < x->get_size()[0]; ++i) {
+                            y->at(i, j) -= x->at(i, j);
+                        }
                     }
                 }
             }
-        }
+        });
     }
 }
 
@@ -453,31 +965,45 @@ void sub_scaled_diag(std::shared_ptr<const DefaultExecutor> exec,
 GKO_INSTANTIATE_FOR_EACH_VALUE_TYPE(GKO_DECLARE_DENSE_SUB_SCALED_DIAG_KERNEL);
 
 
-#pragma omp declare reduction(+ : std::complex<float> : omp_out += omp_in) \
-    initializer(omp_priv = std::complex<float>(0))
+namespace {
+
+
+/**
+ * Computes a * b. Complex products are formed directly from the real and
+ * imaginary parts. This skips the special handling of infinities and NaNs in
+ * the library multiplication, which is an opaque call that prevents
+ * vectorization.
+ */
+template <typename ValueType>
+ValueType multiply(const ValueType& a, const ValueType& b)
+{
+    return a * b;
+}
+
+template <typename ValueType>
+std::complex<ValueType> multiply(const std::complex<ValueType>& a,
+                                 const std::complex<ValueType>& b)
+{
+    return {a.real() * b.real() - a.imag() * b.imag(),
+            a.real() * b.imag() + a.imag() * b.real()};
+}
+
 
-#pragma omp declare reduction(+ : std::complex<double> : omp_out += omp_in) \
-    initializer(omp_priv = std::complex<double>(0))
+}  // namespace
 
-#pragma omp declare reduction(+ : std::complex<long double> : omp_out += \
-                                  omp_in)                                \
-    initializer(omp_priv = std::complex<long double>(0))
 
 template <typename ValueType>
 void compute_dot(std::shared_ptr<const DefaultExecutor> exec,
                  const matrix::Dense<ValueType>* x,
                  const matrix::Dense<ValueType>* y,
-                 matrix::Dense<ValueType>* result, array<char>&)
+                 matrix::Dense<ValueType>* result, array<char>& tmp)
 {
-#pragma omp parallel for
-    for (size_type j = 0; j < x->get_size()[1]; ++j) {
-        auto val = zero<ValueType>();
-#pragma omp simd reduction(+ : val)
-        for (size_type i = 0; i < x->get_size()[0]; ++i) {
-            val += x->at(i, j) * y->at(i, j);
-        }
-        result->at(0, j) = val;
-    }
+    reduce_columns(
+        x, result, tmp,
+        [&](size_type i, size_type j) {
+            return multiply(x->at(i, j), y->at(i, j));
+        },
+        [](ValueType val) { return val; });
 }
 
 GKO_INSTANTIATE_FOR_EACH_VALUE_TYPE(GKO_DECLARE_DENSE_COMPUTE_DOT_KERNEL);
@@ -528,17 +1054,14 @@ template <typename ValueType>
 void compute_conj_dot(std::shared_ptr<const DefaultExecutor> exec,
                       const matrix::Dense<ValueType>* x,
                       const matrix::Dense<ValueType>* y,
-                      matrix::Dense<ValueType>* result, array<char>&)
+                      matrix::Dense<ValueType>* result, array<char>& tmp)
 {
-#pragma omp parallel for
-    for (size_type j = 0; j < x->get_size()[1]; ++j) {
-        auto val = zero<ValueType>();
-#pragma omp simd reduction(+ : val)
-        for (size_type i = 0; i < x->get_size()[0]; ++i) {
-            val += conj(x->at(i, j)) * y->at(i, j);
-        }
-        result->at(0, j) = val;
-    }
+    reduce_columns(
+        x, result, tmp,
+        [&](size_type i, size_type j) {
+            return multiply(conj(x->at(i, j)), y->at(i, j));
+        },
+        [](ValueType val) { return val; });
 }
 
 GKO_INSTANTIATE_FOR_EACH_VALUE_TYPE(GKO_DECLARE_DENSE_COMPUTE_CONJ_DOT_KERNEL);
@@ -558,21 +1081,36 @@ GKO_INSTANTIATE_FOR_EACH_VALUE_TYPE(
     GKO_DECLARE_DENSE_COMPUTE_CONJ_DOT_DISPATCH_KERNEL);
 
 
+template <typename ValueType>
+void compute_multi_conj_dot(std::shared_ptr<const DefaultExecutor> exec,
+                            const matrix::Dense<ValueType>* x,
+                            const matrix::Dense<ValueType>* y,
+                            matrix::Dense<ValueType>* result, array<char>& tmp)
+{
+    const auto num_cols = x->get_size()[1];
+    // all blocks of a tile are reduced while the tile of x is in cache
+    reduce_columns(
+        y, result, tmp,
+        [&](size_type i, size_type j) {
+            return multiply(conj(x->at(i, j % num_cols)), y->at(i, j));
+        },
+        [](ValueType val) { return val; });
+}
+
+GKO_INSTANTIATE_FOR_EACH_VALUE_TYPE(
+    GKO_DECLARE_DENSE_COMPUTE_MULTI_CONJ_DOT_KERNEL);
+
+
 template <typename ValueType>
 void compute_norm2(std::shared_ptr<const DefaultExecutor> exec,
                    const matrix::Dense<ValueType>* x,
                    matrix::Dense<remove_complex<ValueType>>* result,
-                   array<char>&)
+                   array<char>& tmp)
 {
-#pragma omp parallel for
-    for (size_type j = 0; j < x->get_size()[1]; ++j) {
-        auto val = zero<remove_complex<ValueType>>();
-#pragma omp simd reduction(+ : val)
-        for (size_type i = 0; i < x->get_size()[0]; ++i) {
-            val += std::norm(x->at(i, j));
-        }
-        result->at(0, j) = std::sqrt(val);
-    }
+    reduce_columns(
+        x, result, tmp,
+        [&](size_type i, size_type j) { return std::norm(x->at(i, j)); },
+        [](remove_complex<ValueType> val) { return std::sqrt(val); });
 }
 
 GKO_INSTANTIATE_FOR_EACH_VALUE_TYPE(GKO_DECLARE_DENSE_COMPUTE_NORM2_KERNEL);
@@ -595,17 +1133,12 @@ template <typename ValueType>
 void compute_norm1(std::shared_ptr<const DefaultExecutor> exec,
                    const matrix::Dense<ValueType>* x,
                    matrix::Dense<remove_complex<ValueType>>* result,
-                   array<char>&)
+                   array<char>& tmp)
 {
-#pragma omp parallel for
-    for (size_type j = 0; j < x->get_size()[1]; ++j) {
-        auto val = zero<remove_complex<ValueType>>();
-#pragma omp simd reduction(+ : val)
-        for (size_type i = 0; i < x->get_size()[0]; ++i) {
-            val += std::abs(x->at(i, j));
-        }
-        result->at(0, j) = val;
-    }
+    reduce_columns(
+        x, result, tmp,
+        [&](size_type i, size_type j) { return std::abs(x->at(i, j)); },
+        [](remove_complex<ValueType> val) { return val; });
 }
 
 GKO_INSTANTIATE_FOR_EACH_VALUE_TYPE(GKO_DECLARE_DENSE_COMPUTE_NORM1_KERNEL);
@@ -631,17 +1164,12 @@ template <typename ValueType>
 void compute_squared_norm2(std::shared_ptr<const DefaultExecutor> exec,
                            const matrix::Dense<ValueType>* x,
                            matrix::Dense<remove_complex<ValueType>>* result,
-                           array<char>&)
+                           array<char>& tmp)
 {
-#pragma omp parallel for
-    for (size_type j = 0; j < x->get_size()[1]; ++j) {
-        auto val = zero<remove_complex<ValueType>>();
-#pragma omp simd reduction(+ : val)
-        for (size_type i = 0; i < x->get_size()[0]; ++i) {
-            val += std::norm(x->at(i, j));
-        }
-        result->at(0, j) = val;
-    }
+    reduce_columns(
+        x, result, tmp,
+        [&](size_type i, size_type j) { return std::norm(x->at(i, j)); },
+        [](remove_complex<ValueType> val) { return val; });
 }
 
 GKO_INSTANTIATE_FOR_EACH_VALUE_TYPE(
@@ -667,19 +1195,20 @@ GKO_INSTANTIATE_FOR_EACH_NON_COMPLEX_VALUE_TYPE(
 
 template <typename ValueType, typename IndexType>
 void convert_to_coo(std::shared_ptr<const DefaultExecutor> exec,
-                    const matrix::Dense<ValueType>* source, const int64*,
+                    const matrix::Dense<ValueType>* source,
+                    const int64* row_ptrs,
                     matrix::Coo<ValueType, IndexType>* result)
 {
     auto num_rows = result->get_size()[0];
     auto num_cols = result->get_size()[1];
-    auto num_nonzeros = result->get_num_stored_elements();
 
     auto row_idxs = result->get_row_idxs();
     auto col_idxs = result->get_col_idxs();
     auto values = result->get_values();
 
-    size_type idxs = 0;
+#pragma omp parallel for
     for (size_type row = 0; row < num_rows; ++row) {
+        auto idxs = row_ptrs[row];
         for (size_type col = 0; col < num_cols; ++col) {
             auto val = source->at(row, col);
             if (is_nonzero(val)) {
@@ -703,15 +1232,14 @@ void convert_to_csr(std::shared_ptr<const DefaultExecutor> exec,
 {
     auto num_rows = result->get_size()[0];
     auto num_cols = result->get_size()[1];
-    auto num_nonzeros = result->get_num_stored_elements();
 
-    auto row_ptrs = result->get_row_ptrs();
+    auto row_ptrs = result->get_const_row_ptrs();
     auto col_idxs = result->get_col_idxs();
     auto values = result->get_values();
 
-    size_type cur_ptr = 0;
-    row_ptrs[0] = cur_ptr;
+#pragma omp parallel for
     for (size_type row = 0; row < num_rows; ++row) {
+        auto cur_ptr = row_ptrs[row];
         for (size_type col = 0; col < num_cols; ++col) {
             auto val = source->at(row, col);
             if (is_nonzero(val)) {
@@ -720,7 +1248,6 @@ void convert_to_csr(std::shared_ptr<const DefaultExecutor> exec,
                 ++cur_ptr;
             }
         }
-        row_ptrs[row + 1] = cur_ptr;
     }
 }
 
@@ -736,15 +1263,16 @@ void convert_to_ell(std::shared_ptr<const DefaultExecutor> exec,
     auto num_rows = result->get_size()[0];
     auto num_cols = result->get_size()[1];
     auto max_nnz_per_row = result->get_num_stored_elements_per_row();
+#pragma omp parallel for collapse(2)
     for (size_type i = 0; i < max_nnz_per_row; i++) {
         for (size_type j = 0; j < result->get_stride(); j++) {
             result->val_at(j, i) = zero<ValueType>();
             result->col_at(j, i) = invalid_index<IndexType>();
         }
     }
-    size_type col_idx = 0;
+#pragma omp parallel for
     for (size_type row = 0; row < num_rows; row++) {
-        col_idx = 0;
+        size_type col_idx = 0;
         for (size_type col = 0; col < num_cols; col++) {
             auto val = source->at(row, col);
             if (is_nonzero(val)) {
@@ -777,6 +1305,7 @@ void convert_to_fbcsr(std::shared_ptr<const DefaultExecutor> exec,
                                       static_cast<acc::size_type>(bs)},
         result->get_values());
     auto col_idxs = result->get_col_idxs();
+#pragma omp parallel for
     for (size_type brow = 0; brow < num_block_rows; ++brow) {
         auto block = result->get_const_row_ptrs()[brow];
         for (size_type bcol = 0; bcol < num_block_cols; ++bcol) {
@@ -809,17 +1338,18 @@ GKO_INSTANTIATE_FOR_EACH_VALUE_AND_INDEX_TYPE(
 
 template <typename ValueType, typename IndexType>
 void convert_to_hybrid(std::shared_ptr<const DefaultExecutor> exec,
-                       const matrix::Dense<ValueType>* source, const int64*,
+                       const matrix::Dense<ValueType>* source,
+                       const int64* coo_row_ptrs,
                        matrix::Hybrid<ValueType, IndexType>* result)
 {
     auto num_rows = result->get_size()[0];
     auto num_cols = result->get_size()[1];
     auto strategy = result->get_strategy();
     auto ell_lim = strategy->get_ell_num_stored_elements_per_row();
-    auto coo_lim = strategy->get_coo_nnz();
     auto coo_val = result->get_coo_values();
     auto coo_col = result->get_coo_col_idxs();
     auto coo_row = result->get_coo_row_idxs();
+#pragma omp parallel for collapse(2)
     for (size_type i = 0; i < result->get_ell_num_stored_elements_per_row();
          i++) {
         for (size_type j = 0; j < result->get_ell_stride(); j++) {
@@ -828,9 +1358,10 @@ void convert_to_hybrid(std::shared_ptr<const DefaultExecutor> exec,
         }
     }
 
-    size_type coo_idx = 0;
+#pragma omp parallel for
     for (size_type row = 0; row < num_rows; row++) {
         size_type col = 0;
+        auto coo_idx = coo_row_ptrs[row];
         for (size_type col_idx = 0; col < num_cols && col_idx < ell_lim;
              col++) {
             auto val = source->at(row, col);
@@ -865,9 +1396,9 @@ void convert_to_sellp(std::shared_ptr<const DefaultExecutor> exec,
     auto num_cols = result->get_size()[1];
     auto vals = result->get_values();
     auto col_idxs = result->get_col_idxs();
-    auto slice_lengths = result->get_slice_lengths();
     auto slice_sets = result->get_slice_sets();
     auto slice_size = result->get_slice_size();
+#pragma omp parallel for
     for (size_type row = 0; row < num_rows; row++) {
         const auto slice = row / slice_size;
         const auto local_row = row % slice_size;
@@ -900,21 +1431,20 @@ void convert_to_sparsity_csr(std::shared_ptr<const DefaultExecutor> exec,
     auto num_rows = result->get_size()[0];
     auto num_cols = result->get_size()[1];
 
-    auto row_ptrs = result->get_row_ptrs();
+    auto row_ptrs = result->get_const_row_ptrs();
     auto col_idxs = result->get_col_idxs();
     auto value = result->get_value();
     value[0] = one<ValueType>();
-    size_type cur_ptr = 0;
-    row_ptrs[0] = cur_ptr;
+
+#pragma omp parallel for
     for (size_type row = 0; row < num_rows; ++row) {
+        auto cur_ptr = row_ptrs[row];
         for (size_type col = 0; col < num_cols; ++col) {
-            auto val = source->at(row, col);
-            if (is_nonzero(val)) {
+            if (is_nonzero(source->at(row, col))) {
                 col_idxs[cur_ptr] = col;
                 ++cur_ptr;
             }
         }
-        row_ptrs[row + 1] = cur_ptr;
     }
 }
 
@@ -953,18 +1483,17 @@ void compute_slice_sets(std::shared_ptr<const DefaultExecutor> exec,
 {
     const auto num_rows = source->get_size()[0];
     const auto num_cols = source->get_size()[1];
-    const auto num_slices = ceildiv(num_rows, slice_size);
+    const auto num_slices =
+        static_cast<size_type>(ceildiv(num_rows, slice_size));
+#pragma omp parallel for
     for (size_type slice = 0; slice < num_slices; slice++) {
+        const auto slice_end = std::min(num_rows, (slice + 1) * slice_size);
         size_type slice_length = 0;
-#pragma omp parallel for reduction(max : slice_length)
-        for (size_type local_row = 0; local_row < slice_size; local_row++) {
-            const auto row = slice * slice_size + local_row;
+        for (auto row = slice * slice_size; row < slice_end; row++) {
             size_type row_nnz{};
-            if (row < num_rows) {
 #pragma omp simd reduction(+ : row_nnz)
-                for (size_type col = 0; col < num_cols; col++) {
-                    row_nnz += is_nonzero(source->at(row, col));
-                }
+            for (size_type col = 0; col < num_cols; col++) {
+                row_nnz += is_nonzero(source->at(row, col));
             }
             slice_length = std::max<size_type>(
                 slice_length, ceildiv(row_nnz, stride_factor) * stride_factor);
@@ -1012,21 +1541,34 @@ void count_nonzero_blocks_per_row(std::shared_ptr<const DefaultExecutor> exec,
     const auto num_cols = source->get_size()[1];
     const auto num_block_rows = num_rows / bs;
     const auto num_block_cols = num_cols / bs;
-    for (size_type brow = 0; brow < num_block_rows; ++brow) {
-        IndexType num_nonzero_blocks{};
-#pragma omp parallel for reduction(+ : num_nonzero_blocks)
-        for (size_type bcol = 0; bcol < num_block_cols; ++bcol) {
-            bool block_nz = false;
+#pragma omp parallel
+    {
+        // block_nz[bcol] records whether a nonzero was found in the block
+        // (brow, bcol) so far. The rows of a block row are scanned one after
+        // the other, skipping the blocks already known to be nonzero.
+        array<bool> block_nz_array{exec, num_block_cols};
+        const auto block_nz = block_nz_array.get_data();
+#pragma omp for
+        for (size_type brow = 0; brow < num_block_rows; ++brow) {
+            std::fill_n(block_nz, num_block_cols, false);
+            IndexType num_nonzero_blocks{};
             for (int lrow = 0; lrow < bs; ++lrow) {
-                for (int lcol = 0; lcol < bs; ++lcol) {
-                    const auto row = lrow + bs * brow;
-                    const auto col = lcol + bs * bcol;
-                    block_nz = block_nz || is_nonzero(source->at(row, col));
+                const auto row = lrow + bs * brow;
+                for (size_type bcol = 0; bcol < num_block_cols; ++bcol) {
+                    if (block_nz[bcol]) {
+                        continue;
+                    }
+                    bool nz = false;
+                    for (int lcol = 0; lcol < bs; ++lcol) {
+                        const auto col = lcol + bs * bcol;
+                        nz = nz || is_nonzero(source->at(row, col));
+                    }
+                    block_nz[bcol] = nz;
+                    num_nonzero_blocks += nz ? 1 : 0;
                 }
             }
-            num_nonzero_blocks += block_nz ? 1 : 0;
+            result[brow] = num_nonzero_blocks;
         }
-        result[brow] = num_nonzero_blocks;
     }
 }
 
@@ -1034,18 +1576,56 @@ GKO_INSTANTIATE_FOR_EACH_VALUE_AND_INDEX_TYPE(
     GKO_DECLARE_DENSE_COUNT_NONZERO_BLOCKS_PER_ROW_KERNEL);
 
 
+namespace {
+
+
+/**
+ * Size of the square tiles the transpositions go over. A tile spans few
+ * enough rows of both the original and the transposed matrix for all of them
+ * to stay in cache, so the strided accesses of one side hit the cache lines
+ * loaded for the previous columns of the tile.
+ */
+constexpr size_type transpose_block_size = 32;
+
+
+/**
+ * Computes trans(j, i) = op(orig(i, j)) tile by tile.
+ */
+template <typename ValueType, typename Operation>
+void transpose_blocked(const matrix::Dense<ValueType>* orig,
+                       matrix::Dense<ValueType>* trans, Operation op)
+{
+    const auto num_rows = orig->get_size()[0];
+    const auto num_cols = orig->get_size()[1];
+#pragma omp parallel for collapse(2)
+    for (size_type row_block = 0; row_block < num_rows;
+         row_block += transpose_block_size) {
+        for (size_type col_block = 0; col_block < num_cols;
+             col_block += transpose_block_size) {
+            const auto row_end =
+                std::min(row_block + transpose_block_size, num_rows);
+            const auto col_end =
+                std::min(col_block + transpose_block_size, num_cols);
+            for (auto col = col_block; col < col_end; ++col) {
+#pragma omp simd
+                for (auto row = row_block; row < row_end; ++row) {
+                    trans->at(col, row) = op(orig->at(row, col));
+                }
+            }
+        }
+    }
+}
+
+
+}  // namespace
+
+
 template <typename ValueType>
 void transpose(std::shared_ptr<const DefaultExecutor> exec,
                const matrix::Dense<ValueType>* orig,
                matrix::Dense<ValueType>* trans)
 {
-#pragma omp parallel for
-    for (size_type i = 0; i < orig->get_size()[0]; ++i) {
-#pragma omp simd
-        for (size_type j = 0; j < orig->get_size()[1]; ++j) {
-            trans->at(j, i) = orig->at(i, j);
-        }
-    }
+    transpose_blocked(orig, trans, [](ValueType val) { return val; });
 }
 
 GKO_INSTANTIATE_FOR_EACH_VALUE_TYPE(GKO_DECLARE_DENSE_TRANSPOSE_KERNEL);
@@ -1056,16 +1636,40 @@ void conj_transpose(std::shared_ptr<const DefaultExecutor> exec,
                     const matrix::Dense<ValueType>* orig,
                     matrix::Dense<ValueType>* trans)
 {
+    transpose_blocked(orig, trans, [](ValueType val) { return conj(val); });
+}
+
+GKO_INSTANTIATE_FOR_EACH_VALUE_TYPE(GKO_DECLARE_DENSE_CONJ_TRANSPOSE_KERNEL);
+
+
+namespace {
+
+
+/**
+ * Computes the inverse of the permutation `permutation_indices`.
+ *
+ * The inverse permutation kernels use it to gather from the original matrix
+ * instead of scattering into the permuted one, so the stores are contiguous
+ * and the indirect loads can be vectorized.
+ */
+template <typename IndexType>
+array<IndexType> invert_permutation(
+    std::shared_ptr<const DefaultExecutor> exec,
+    const array<IndexType>* permutation_indices)
+{
+    const auto size = permutation_indices->get_num_elems();
+    const auto perm = permutation_indices->get_const_data();
+    array<IndexType> inv_permutation{exec, size};
+    const auto inv_perm = inv_permutation.get_data();
 #pragma omp parallel for
-    for (size_type i = 0; i < orig->get_size()[0]; ++i) {
-#pragma omp simd
-        for (size_type j = 0; j < orig->get_size()[1]; ++j) {
-            trans->at(j, i) = conj(orig->at(i, j));
-        }
+    for (size_type i = 0; i < size; ++i) {
+        inv_perm[perm[i]] = static_cast<IndexType>(i);
     }
+    return inv_permutation;
 }
 
-GKO_INSTANTIATE_FOR_EACH_VALUE_TYPE(GKO_DECLARE_DENSE_CONJ_TRANSPOSE_KERNEL);
+
+}  // namespace
 
 
 template <typename ValueType, typename IndexType>
@@ -1095,13 +1699,14 @@ void inv_symm_permute(std::shared_ptr<const DefaultExecutor> exec,
                       const matrix::Dense<ValueType>* orig,
                       matrix::Dense<ValueType>* permuted)
 {
-    auto perm = permutation_indices->get_const_data();
+    const auto inv_permutation = invert_permutation(exec, permutation_indices);
+    const auto inv_perm = inv_permutation.get_const_data();
     auto size = orig->get_size()[0];
 #pragma omp parallel for
     for (size_type i = 0; i < size; ++i) {
 #pragma omp simd
         for (size_type j = 0; j < size; ++j) {
-            permuted->at(perm[i], perm[j]) = orig->at(i, j);
+            permuted->at(i, j) = orig->at(inv_perm[i], inv_perm[j]);
         }
     }
 }
@@ -1168,9 +1773,9 @@ void column_permute(std::shared_ptr<const DefaultExecutor> exec,
 {
     auto perm = permutation_indices->get_const_data();
 #pragma omp parallel for
-    for (size_type j = 0; j < orig->get_size()[1]; ++j) {
+    for (size_type i = 0; i < orig->get_size()[0]; ++i) {
 #pragma omp simd
-        for (size_type i = 0; i < orig->get_size()[0]; ++i) {
+        for (size_type j = 0; j < orig->get_size()[1]; ++j) {
             column_permuted->at(i, j) = orig->at(i, perm[j]);
         }
     }
@@ -1206,12 +1811,13 @@ void inverse_column_permute(std::shared_ptr<const DefaultExecutor> exec,
                             const matrix::Dense<ValueType>* orig,
                             matrix::Dense<ValueType>* column_permuted)
 {
-    auto perm = permutation_indices->get_const_data();
+    const auto inv_permutation = invert_permutation(exec, permutation_indices);
+    const auto inv_perm = inv_permutation.get_const_data();
 #pragma omp parallel for
-    for (size_type j = 0; j < orig->get_size()[1]; ++j) {
+    for (size_type i = 0; i < orig->get_size()[0]; ++i) {
 #pragma omp simd
-        for (size_type i = 0; i < orig->get_size()[0]; ++i) {
-            column_permuted->at(i, perm[j]) = orig->at(i, j);
+        for (size_type j = 0; j < orig->get_size()[1]; ++j) {
+            column_permuted->at(i, j) = orig->at(i, inv_perm[j]);
         }
     }
 }
@@ -1331,55 +1937,38 @@ void add_scaled_identity(std::shared_ptr<const DefaultExecutor> exec,
                          matrix::Dense<ValueType>* const mtx)
 {
     const auto dim = mtx->get_size();
+    const auto diag_size = std::min(dim[0], dim[1]);
     const auto vbeta = beta->get_const_values()[0];
     const auto valpha = alpha->get_const_values()[0];
     if (is_nonzero(vbeta)) {
         if (vbeta != one<ValueType>()) {
-            if (is_nonzero(valpha)) {
-#pragma omp parallel for collapse(2)
-                for (size_type row = 0; row < dim[0]; row++) {
-                    for (size_type col = 0; col < dim[1]; col++) {
-                        mtx->at(row, col) *= vbeta;
-                        if (row == col) {
-                            mtx->at(row, row) += valpha;
-                        }
-                    }
-                }
-            } else {
 #pragma omp parallel for
-                for (size_type row = 0; row < dim[0]; row++) {
+            for (size_type row = 0; row < dim[0]; row++) {
 #pragma omp simd
-                    for (size_type col = 0; col < dim[1]; col++) {
-                        mtx->at(row, col) *= vbeta;
-                    }
+                for (size_type col = 0; col < dim[1]; col++) {
+                    mtx->at(row, col) *= vbeta;
                 }
-            }
-        } else {
-            if (is_nonzero(valpha)) {
-#pragma omp parallel for collapse(2)
-                for (size_type row = 0; row < dim[0]; row++) {
-                    for (size_type col = 0; col < dim[1]; col++) {
-                        if (row == col) {
-                            mtx->at(row, row) += valpha;
-                        }
-                    }
+                if (is_nonzero(valpha) && row < diag_size) {
+                    mtx->at(row, row) += valpha;
                 }
             }
+        } else if (is_nonzero(valpha)) {
+            // only the diagonal changes
+#pragma omp parallel for
+            for (size_type row = 0; row < diag_size; row++) {
+                mtx->at(row, row) += valpha;
+            }
         }
     } else {
-        if (is_nonzero(valpha)) {
-#pragma omp parallel for collapse(2)
-            for (size_type row = 0; row < dim[0]; row++) {
-                for (size_type col = 0; col < dim[1]; col++) {
-                    if (row == col) {
-                        mtx->at(row, row) = valpha;
-                    } else {
-                        mtx->at(row, col) = zero<ValueType>();
-                    }
-                }
+#pragma omp parallel for
+        for (size_type row = 0; row < dim[0]; row++) {
+#pragma omp simd
+            for (size_type col = 0; col < dim[1]; col++) {
+                mtx->at(row, col) = zero<ValueType>();
+            }
+            if (is_nonzero(valpha) && row < diag_size) {
+                mtx->at(row, row) = valpha;
             }
-        } else {
-            fill(exec, mtx, zero<ValueType>());
         }
     }
 }
@@ -33,12 +33,21 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "core/solver/cg_kernels.hpp"
 
 
+#include <algorithm>
+#include <memory>
+
+
 #include <ginkgo/core/base/array.hpp>
 #include <ginkgo/core/base/exception_helpers.hpp>
 #include <ginkgo/core/base/math.hpp>
 #include <ginkgo/core/base/types.hpp>
 
 
+#include "core/synthesizer/implementation_selection.hpp"
+#include "omp/base/column_reduction.hpp"
+#include "omp/base/parallel_team.hpp"
+
+
 namespace gko {
 namespace kernels {
 namespace omp {
@@ -50,6 +59,201 @@ namespace omp {
 namespace cg {
 
 
+namespace {
+
+
+/**
+ * Number of columns up to which column_buffer does not allocate memory.
+ */
+constexpr size_type max_fixed_cols = 64;
+
+
+/**
+ * Storage for one value per column of the CG vectors, e.g. the indices of the
+ * active columns. Up to max_fixed_cols values are kept in a fixed buffer on
+ * the stack, so the updates only allocate memory for unusually large numbers
+ * of right-hand sides.
+ */
+template <typename T>
+class column_buffer {
+public:
+    column_buffer(std::shared_ptr<const Executor> exec, size_type num_cols)
+        : heap_{exec}, data_{fixed_}
+    {
+        if (num_cols > max_fixed_cols) {
+            heap_.resize_and_reset(num_cols);
+            data_ = heap_.get_data();
+        }
+    }
+
+    column_buffer(const column_buffer&) = delete;
+
+    column_buffer& operator=(const column_buffer&) = delete;
+
+    T* get_data() { return data_; }
+
+private:
+    T fixed_[max_fixed_cols];
+    array<T> heap_;
+    T* data_;
+};
+
+
+/**
+ * Stores the indices of the columns that have not stopped yet at the beginning
+ * of `active_cols`, so the updates only iterate over these columns.
+ *
+ * @param stop_status  the stopping status of each column
+ * @param num_cols  the number of columns
+ * @param active_cols  the output indices, of size at least `num_cols`
+ *
+ * @return the number of active columns
+ */
+size_type compact_active_columns(const array<stopping_status>* stop_status,
+                                 size_type num_cols, size_type* active_cols)
+{
+    size_type num_active = 0;
+    for (size_type j = 0; j < num_cols; ++j) {
+        if (!stop_status->get_const_data()[j].has_stopped()) {
+            active_cols[num_active++] = j;
+        }
+    }
+    return num_active;
+}
+
+
+/**
+ * Returns the coefficient of p in the update p = z + (rho / prev_rho) * p of
+ * column `j`, or zero if it is undefined.
+ */
+template <typename ValueType>
+ValueType get_step_1_coefficient(const matrix::Dense<ValueType>* rho,
+                                 const matrix::Dense<ValueType>* prev_rho,
+                                 size_type j)
+{
+    const auto prev_rho_value = prev_rho->at(j);
+    if (is_nonzero(prev_rho_value)) {
+        const auto rho_value = rho->at(j);
+        if (is_nonzero(rho_value)) {
+            return rho_value / prev_rho_value;
+        }
+    }
+    return zero<ValueType>();
+}
+
+
+/**
+ * Returns the step length rho / beta of column `j`, or zero if it is
+ * undefined.
+ */
+template <typename ValueType>
+ValueType get_step_2_coefficient(const matrix::Dense<ValueType>* rho,
+                                 const matrix::Dense<ValueType>* beta,
+                                 size_type j)
+{
+    const auto rho_value = rho->at(j);
+    if (is_nonzero(rho_value)) {
+        const auto beta_value = beta->at(j);
+        if (is_nonzero(beta_value)) {
+            return rho_value / beta_value;
+        }
+    }
+    return zero<ValueType>();
+}
+
+
+/**
+ * Numbers of columns for which the CG updates are compiled with a fixed
+ * width. For these, the loop over the columns of a row is fully unrolled and
+ * the coefficients of all columns stay in registers.
+ */
+using compiled_num_cols = syn::value_list<int, 1, 2, 4, 8>;
+
+
+/**
+ * Checks whether the fixed-width updates can be used, i.e. whether the number
+ * of columns is one of compiled_num_cols and all columns are active with a
+ * nonzero coefficient. The generic updates handle the remaining cases.
+ * With at most 8 columns, the rows alone provide enough parallelism, so the
+ * fixed-width updates always use the row split of get_thread_range.
+ */
+template <typename CoefficientFunction>
+bool use_fixed_num_cols(size_type num_cols, size_type num_active,
+                        CoefficientFunction get_coefficient)
+{
+    const auto widths = syn::as_array(compiled_num_cols());
+    if (num_active != num_cols ||
+        std::find(widths.begin(), widths.end(), static_cast<int>(num_cols)) ==
+            widths.end()) {
+        return false;
+    }
+    for (size_type j = 0; j < num_cols; ++j) {
+        if (is_zero(get_coefficient(j))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+
+template <int num_cols, typename ValueType>
+void step_1_fixed(syn::value_list<int, num_cols>, matrix::Dense<ValueType>* p,
+                  const matrix::Dense<ValueType>* z,
+                  const matrix::Dense<ValueType>* rho,
+                  const matrix::Dense<ValueType>* prev_rho)
+{
+    const auto num_rows = p->get_size()[0];
+    ValueType coefficients[num_cols];
+    for (int j = 0; j < num_cols; ++j) {
+        coefficients[j] = get_step_1_coefficient(rho, prev_rho, j);
+    }
+    run_on_team([&] {
+        const auto rows = get_thread_range(num_rows);
+        for (auto i = rows.begin; i < rows.end; ++i) {
+#pragma omp simd
+            for (int j = 0; j < num_cols; ++j) {
+                p->at(i, j) = z->at(i, j) + coefficients[j] * p->at(i, j);
+            }
+        }
+#pragma omp barrier
+    });
+}
+
+GKO_ENABLE_IMPLEMENTATION_SELECTION(select_step_1_fixed, step_1_fixed);
+
+
+template <int num_cols, typename ValueType>
+void step_2_fixed(syn::value_list<int, num_cols>, matrix::Dense<ValueType>* x,
+                  matrix::Dense<ValueType>* r,
+                  const matrix::Dense<ValueType>* p,
+                  const matrix::Dense<ValueType>* q,
+                  const matrix::Dense<ValueType>* beta,
+                  const matrix::Dense<ValueType>* rho)
+{
+    const auto num_rows = x->get_size()[0];
+    ValueType coefficients[num_cols];
+    for (int j = 0; j < num_cols; ++j) {
+        coefficients[j] = get_step_2_coefficient(rho, beta, j);
+    }
+    run_on_team([&] {
+        const auto rows = get_thread_range(num_rows);
+        for (auto i = rows.begin; i < rows.end; ++i) {
+#pragma omp simd
+            for (int j = 0; j < num_cols; ++j) {
+                x->at(i, j) += coefficients[j] * p->at(i, j);
+                r->at(i, j) -= coefficients[j] * q->at(i, j);
+            }
+        }
+#pragma omp barrier
+    });
+}
+
+GKO_ENABLE_IMPLEMENTATION_SELECTION(select_step_2_fixed, step_2_fixed);
+
+
+}  // namespace
+
+
 template <typename ValueType>
 void initialize(std::shared_ptr<const DefaultExecutor> exec,
                 const matrix::Dense<ValueType>* b, matrix::Dense<ValueType>* r,
@@ -58,22 +262,29 @@ void initialize(std::shared_ptr<const DefaultExecutor> exec,
                 matrix::Dense<ValueType>* rho,
                 array<stopping_status>* stop_status)
 {
-#pragma omp parallel
-    {
-#pragma omp for simd nowait
-        for (size_type j = 0; j < b->get_size()[1]; ++j) {
+    const auto num_rows = b->get_size()[0];
+    const auto num_cols = b->get_size()[1];
+    const auto row_block_size = get_row_block_size(r);
+    run_on_team([&] {
+#pragma omp for simd schedule(static) nowait
+        for (size_type j = 0; j < num_cols; ++j) {
             rho->at(j) = zero<ValueType>();
             prev_rho->at(j) = one<ValueType>();
             stop_status->get_data()[j].reset();
         }
-#pragma omp for simd collapse(2) nowait
-        for (size_type i = 0; i < b->get_size()[0]; ++i) {
-            for (size_type j = 0; j < b->get_size()[1]; ++j) {
-                r->at(i, j) = b->at(i, j);
-                z->at(i, j) = p->at(i, j) = q->at(i, j) = zero<ValueType>();
-            }
-        }
-    }
+        for_each_tile(
+            num_rows, num_cols, row_block_size, [&](span rows, span cols) {
+                for (auto j = cols.begin; j < cols.end; ++j) {
+#pragma omp simd
+                    for (auto i = rows.begin; i < rows.end; ++i) {
+                        r->at(i, j) = b->at(i, j);
+                        z->at(i, j) = p->at(i, j) = q->at(i, j) =
+                            zero<ValueType>();
+                    }
+                }
+            });
+#pragma omp barrier
+    });
 }
 
 GKO_INSTANTIATE_FOR_EACH_VALUE_TYPE(GKO_DECLARE_CG_INITIALIZE_KERNEL);
@@ -86,37 +297,51 @@ void step_1(std::shared_ptr<const DefaultExecutor> exec,
             const matrix::Dense<ValueType>* prev_rho,
             const array<stopping_status>* stop_status)
 {
-#pragma omp parallel for
-    for (size_type j = 0; j < p->get_size()[1]; ++j) {
-        if (!stop_status->get_const_data()[j].has_stopped()) {
-            const auto prev_rho_value = prev_rho->at(j);
-            auto val = zero<ValueType>();
-            if (is_nonzero(prev_rho_value)) {
-                const auto rho_value = rho->at(j);
-                if (is_nonzero(rho_value)) {
-                    val = rho_value / prev_rho_value;
-                }
-            }
-            if (is_zero(val)) {
-#pragma omp simd
-                for (size_type i = 0; i < p->get_size()[0]; ++i) {
-                    p->at(i, j) = z->at(i, j);
-                }
-            } else {
-                if (val != one<ValueType>()) {
+    const auto num_rows = p->get_size()[0];
+    const auto num_cols = p->get_size()[1];
+    column_buffer<size_type> active_cols{exec, num_cols};
+    const auto cols = active_cols.get_data();
+    const auto num_active = compact_active_columns(stop_status, num_cols, cols);
+    if (use_fixed_num_cols(num_cols, num_active, [&](size_type j) {
+            return get_step_1_coefficient(rho, prev_rho, j);
+        })) {
+        select_step_1_fixed(
+            compiled_num_cols(),
+            [&](int compiled) {
+                return static_cast<size_type>(compiled) == num_cols;
+            },
+            syn::value_list<int>(), syn::type_list<>(), p, z, rho, prev_rho);
+        return;
+    }
+    const auto row_block_size = get_row_block_size(p);
+    run_on_team([&] {
+        for_each_tile(num_rows, num_active, row_block_size, [&](span rows,
+                                                                span active) {
+            for (auto k = active.begin; k < active.end; ++k) {
+                const auto j = cols[k];
+                const auto val = get_step_1_coefficient(rho, prev_rho, j);
+                if (is_zero(val)) {
 #pragma omp simd
-                    for (size_type i = 0; i < p->get_size()[0]; ++i) {
-                        p->at(i, j) = z->at(i, j) + (val * p->at(i, j));
+                    for (auto i = rows.begin; i < rows.end; ++i) {
+                        p->at(i, j) = z->at(i, j);
                     }
                 } else {
+                    if (val != one<ValueType>()) {
 #pragma omp simd
-                    for (size_type i = 0; i < p->get_size()[0]; ++i) {
-                        p->at(i, j) += z->at(i, j);
+                        for (auto i = rows.begin; i < rows.end; ++i) {
+                            p->at(i, j) = z->at(i, j) + (val * p->at(i, j));
+                        }
+                    } else {
+#pragma omp simd
+                        for (auto i = rows.begin; i < rows.end; ++i) {
+                            p->at(i, j) = p->at(i, j) + z->at(i, j);
+                        }
                     }
                 }
             }
-        }
-    }
+        });
+#pragma omp barrier
+    });
 }
 
 GKO_INSTANTIATE_FOR_EACH_VALUE_TYPE(GKO_DECLARE_CG_STEP_1_KERNEL);
@@ -131,37 +356,362 @@ void step_2(std::shared_ptr<const DefaultExecutor> exec,
             const matrix::Dense<ValueType>* rho,
             const array<stopping_status>* stop_status)
 {
-#pragma omp parallel for
-    for (size_type j = 0; j < p->get_size()[1]; ++j) {
-        if (!stop_status->get_const_data()[j].has_stopped()) {
-            const auto rho_value = rho->at(j);
-            auto val = zero<ValueType>();
-            if (is_nonzero(rho_value)) {
-                const auto beta_value = beta->at(j);
-                if (is_nonzero(beta_value)) {
-                    val = rho_value / beta_value;
+    const auto num_rows = p->get_size()[0];
+    const auto num_cols = p->get_size()[1];
+    column_buffer<size_type> active_cols{exec, num_cols};
+    const auto cols = active_cols.get_data();
+    const auto num_active = compact_active_columns(stop_status, num_cols, cols);
+    if (use_fixed_num_cols(num_cols, num_active, [&](size_type j) {
+            return get_step_2_coefficient(rho, beta, j);
+        })) {
+        select_step_2_fixed(
+            compiled_num_cols(),
+            [&](int compiled) {
+                return static_cast<size_type>(compiled) == num_cols;
+            },
+            syn::value_list<int>(), syn::type_list<>(), x, r, p, q, beta,
+            rho);
+        return;
+    }
+    const auto row_block_size = get_row_block_size(x);
+    run_on_team([&] {
+        for_each_tile(num_rows, num_active, row_block_size, [&](span rows,
+                                                                span active) {
+            for (auto k = active.begin; k < active.end; ++k) {
+                const auto j = cols[k];
+                const auto val = get_step_2_coefficient(rho, beta, j);
+                if (is_nonzero(val)) {
+                    if (val != one<ValueType>()) {
+#pragma omp simd
+                        for (auto i = rows.begin; i < rows.end; ++i) {
+                            x->at(i, j) += val * p->at(i, j);
+                            r->at(i, j) -= val * q->at(i, j);
+                        }
+                    } else {
+#pragma omp simd
+                        for (auto i = rows.begin; i < rows.end; ++i) {
+                            x->at(i, j) += p->at(i, j);
+                            r->at(i, j) -= q->at(i, j);
+                        }
+                    }
                 }
             }
-            if (is_nonzero(val)) {
-                if (val != one<ValueType>()) {
+        });
+#pragma omp barrier
+    });
+}
+
+GKO_INSTANTIATE_FOR_EACH_VALUE_TYPE(GKO_DECLARE_CG_STEP_2_KERNEL);
+
+
+template <typename ValueType>
+void step_2_fused(std::shared_ptr<const DefaultExecutor> exec,
+                  matrix::Dense<ValueType>* x, matrix::Dense<ValueType>* r,
+                  const matrix::Dense<ValueType>* p,
+                  const matrix::Dense<ValueType>* q,
+                  const matrix::Dense<ValueType>* beta,
+                  matrix::Dense<ValueType>* prev_rho,
+                  matrix::Dense<ValueType>* rho, array<char>& tmp,
+                  const array<stopping_status>* stop_status)
+{
+    const auto num_cols = x->get_size()[1];
+    column_buffer<ValueType> step_lengths{exec, num_cols};
+    const auto alpha = step_lengths.get_data();
+    for (size_type j = 0; j < num_cols; ++j) {
+        alpha[j] = stop_status->get_const_data()[j].has_stopped()
+                       ? zero<ValueType>()
+                       : get_step_2_coefficient(rho, beta, j);
+        prev_rho->at(j) = rho->at(j);
+    }
+    // each entry of r is updated right before it is added to r^H r, so the
+    // vectors are only streamed once
+    reduce_columns(
+        r, rho, tmp,
+        [&](size_type i, size_type j) {
+            if (is_nonzero(alpha[j])) {
+                x->at(i, j) += alpha[j] * p->at(i, j);
+                r->at(i, j) -= alpha[j] * q->at(i, j);
+            }
+            return static_cast<ValueType>(squared_norm(r->at(i, j)));
+        },
+        [](ValueType value) { return value; });
+}
+
+GKO_INSTANTIATE_FOR_EACH_VALUE_TYPE(GKO_DECLARE_CG_STEP_2_FUSED_KERNEL);
+
+
+template <typename ValueType>
+void step_2_jacobi(std::shared_ptr<const DefaultExecutor> exec,
+                   matrix::Dense<ValueType>* x, matrix::Dense<ValueType>* r,
+                   matrix::Dense<ValueType>* z,
+                   const matrix::Dense<ValueType>* p,
+                   const matrix::Dense<ValueType>* q,
+                   const matrix::Diagonal<ValueType>* inv_diag,
+                   const matrix::Dense<ValueType>* beta,
+                   matrix::Dense<ValueType>* prev_rho,
+                   matrix::Dense<ValueType>* rho, array<char>& tmp,
+                   const array<stopping_status>* stop_status)
+{
+    const auto num_cols = x->get_size()[1];
+    const auto diag = inv_diag->get_const_values();
+    column_buffer<ValueType> step_lengths{exec, num_cols};
+    const auto alpha = step_lengths.get_data();
+    for (size_type j = 0; j < num_cols; ++j) {
+        alpha[j] = stop_status->get_const_data()[j].has_stopped()
+                       ? zero<ValueType>()
+                       : get_step_2_coefficient(rho, beta, j);
+        prev_rho->at(j) = rho->at(j);
+    }
+    // conj(r) * z = diag * |r|^2 avoids a complex product
+    reduce_columns(
+        r, rho, tmp,
+        [&](size_type i, size_type j) {
+            if (is_nonzero(alpha[j])) {
+                x->at(i, j) += alpha[j] * p->at(i, j);
+                r->at(i, j) -= alpha[j] * q->at(i, j);
+            }
+            z->at(i, j) = diag[i] * r->at(i, j);
+            return diag[i] * squared_norm(r->at(i, j));
+        },
+        [](ValueType value) { return value; });
+}
+
+GKO_INSTANTIATE_FOR_EACH_VALUE_TYPE(GKO_DECLARE_CG_STEP_2_JACOBI_KERNEL);
+
+
+template <typename ValueType>
+void initialize_pipelined(std::shared_ptr<const DefaultExecutor> exec,
+                          const matrix::Dense<ValueType>* b,
+                          matrix::Dense<ValueType>* r,
+                          matrix::Dense<ValueType>* p,
+                          matrix::Dense<ValueType>* q,
+                          matrix::Dense<ValueType>* s,
+                          matrix::Dense<ValueType>* z,
+                          matrix::Dense<ValueType>* prev_rho,
+                          matrix::Dense<ValueType>* alpha,
+                          array<stopping_status>* stop_status)
+{
+    const auto num_rows = b->get_size()[0];
+    const auto num_cols = b->get_size()[1];
+    const auto row_block_size = get_row_block_size(r);
+    run_on_team([&] {
+#pragma omp for simd schedule(static) nowait
+        for (size_type j = 0; j < num_cols; ++j) {
+            prev_rho->at(j) = zero<ValueType>();
+            alpha->at(j) = one<ValueType>();
+            stop_status->get_data()[j].reset();
+        }
+        for_each_tile(
+            num_rows, num_cols, row_block_size, [&](span rows, span cols) {
+                for (auto j = cols.begin; j < cols.end; ++j) {
 #pragma omp simd
-                    for (size_type i = 0; i < p->get_size()[0]; ++i) {
-                        x->at(i, j) += val * p->at(i, j);
-                        r->at(i, j) -= val * q->at(i, j);
+                    for (auto i = rows.begin; i < rows.end; ++i) {
+                        r->at(i, j) = b->at(i, j);
+                        p->at(i, j) = q->at(i, j) = s->at(i, j) =
+                            z->at(i, j) = zero<ValueType>();
                     }
-                } else {
+                }
+            });
+#pragma omp barrier
+    });
+}
+
+GKO_INSTANTIATE_FOR_EACH_VALUE_TYPE(GKO_DECLARE_CG_INITIALIZE_PIPELINED_KERNEL);
+
+
+template <typename ValueType>
+void step_1_pipelined(std::shared_ptr<const DefaultExecutor> exec,
+                      const matrix::Dense<ValueType>* r,
+                      const matrix::Dense<ValueType>* u,
+                      const matrix::Dense<ValueType>* w,
+                      matrix::Dense<ValueType>* dots, array<char>& tmp)
+{
+    const auto num_cols = r->get_size()[1];
+    // both dot products of a column are reduced in the same tile, so each
+    // entry of u is only loaded from memory once
+    reduce_columns(
+        dim<2>{r->get_size()[0], 2 * num_cols}, get_row_block_size(u), dots,
+        tmp,
+        [&](size_type i, size_type j) {
+            return j < num_cols
+                       ? conj(r->at(i, j)) * u->at(i, j)
+                       : conj(w->at(i, j - num_cols)) * u->at(i, j - num_cols);
+        },
+        [](ValueType value) { return value; });
+}
+
+GKO_INSTANTIATE_FOR_EACH_VALUE_TYPE(GKO_DECLARE_CG_STEP_1_PIPELINED_KERNEL);
+
+
+template <typename ValueType>
+void step_2_pipelined(
+    std::shared_ptr<const DefaultExecutor> exec, matrix::Dense<ValueType>* x,
+    matrix::Dense<ValueType>* r, matrix::Dense<ValueType>* u,
+    matrix::Dense<ValueType>* w, matrix::Dense<ValueType>* p,
+    matrix::Dense<ValueType>* q, matrix::Dense<ValueType>* s,
+    matrix::Dense<ValueType>* z, const matrix::Dense<ValueType>* m,
+    const matrix::Dense<ValueType>* n, const matrix::Dense<ValueType>* dots,
+    matrix::Dense<ValueType>* prev_rho, matrix::Dense<ValueType>* alpha,
+    const array<stopping_status>* stop_status)
+{
+    const auto num_rows = x->get_size()[0];
+    const auto num_cols = x->get_size()[1];
+    column_buffer<size_type> active_cols{exec, num_cols};
+    column_buffer<ValueType> directions{exec, num_cols};
+    column_buffer<ValueType> step_lengths{exec, num_cols};
+    const auto cols = active_cols.get_data();
+    const auto beta = directions.get_data();
+    const auto step = step_lengths.get_data();
+    const auto num_active = compact_active_columns(stop_status, num_cols, cols);
+    for (size_type k = 0; k < num_active; ++k) {
+        const auto j = cols[k];
+        const auto gamma = dots->at(0, j);
+        beta[j] = safe_divide(gamma, prev_rho->at(j));
+        step[j] = safe_divide(
+            gamma, dots->at(0, num_cols + j) -
+                       safe_divide(beta[j] * gamma, alpha->at(j)));
+    }
+    const auto row_block_size = get_row_block_size(x);
+    run_on_team([&] {
+        for_each_tile(num_rows, num_active, row_block_size, [&](span rows,
+                                                                span active) {
+            for (auto k = active.begin; k < active.end; ++k) {
+                const auto j = cols[k];
 #pragma omp simd
-                    for (size_type i = 0; i < p->get_size()[0]; ++i) {
-                        x->at(i, j) += p->at(i, j);
-                        r->at(i, j) -= q->at(i, j);
-                    }
+                for (auto i = rows.begin; i < rows.end; ++i) {
+                    z->at(i, j) = n->at(i, j) + beta[j] * z->at(i, j);
+                    q->at(i, j) = m->at(i, j) + beta[j] * q->at(i, j);
+                    s->at(i, j) = w->at(i, j) + beta[j] * s->at(i, j);
+                    p->at(i, j) = u->at(i, j) + beta[j] * p->at(i, j);
+                    x->at(i, j) += step[j] * p->at(i, j);
+                    r->at(i, j) -= step[j] * s->at(i, j);
+                    u->at(i, j) -= step[j] * q->at(i, j);
+                    w->at(i, j) -= step[j] * z->at(i, j);
                 }
             }
+        });
+#pragma omp barrier
+        // all threads have read the old coefficients at this point
+#pragma omp single
+        for (size_type k = 0; k < num_active; ++k) {
+            const auto j = cols[k];
+            prev_rho->at(j) = dots->at(0, j);
+            alpha->at(j) = step[j];
         }
-    }
+    });
 }
 
-GKO_INSTANTIATE_FOR_EACH_VALUE_TYPE(GKO_DECLARE_CG_STEP_2_KERNEL);
+GKO_INSTANTIATE_FOR_EACH_VALUE_TYPE(GKO_DECLARE_CG_STEP_2_PIPELINED_KERNEL);
+
+
+template <typename ValueType>
+void step_1_deflated(std::shared_ptr<const DefaultExecutor> exec,
+                     matrix::Dense<ValueType>* p,
+                     const matrix::Dense<ValueType>* z,
+                     const matrix::Dense<ValueType>* basis,
+                     const matrix::Dense<ValueType>* mu,
+                     const matrix::Dense<ValueType>* rho,
+                     const matrix::Dense<ValueType>* prev_rho,
+                     const array<stopping_status>* stop_status)
+{
+    const auto num_rows = p->get_size()[0];
+    const auto num_cols = p->get_size()[1];
+    const auto num_vectors = basis->get_size()[1];
+    column_buffer<size_type> active_cols{exec, num_cols};
+    const auto cols = active_cols.get_data();
+    const auto num_active = compact_active_columns(stop_status, num_cols, cols);
+    const auto row_block_size = get_row_block_size(p);
+    run_on_team([&] {
+        for_each_tile(num_rows, num_active, row_block_size, [&](span rows,
+                                                                span active) {
+            for (auto k = active.begin; k < active.end; ++k) {
+                const auto j = cols[k];
+                const auto beta = safe_divide(rho->at(j), prev_rho->at(j));
+#pragma omp simd
+                for (auto i = rows.begin; i < rows.end; ++i) {
+                    auto val = z->at(i, j) + beta * p->at(i, j);
+                    for (size_type l = 0; l < num_vectors; ++l) {
+                        val -= basis->at(i, l) * mu->at(l, j);
+                    }
+                    p->at(i, j) = val;
+                }
+            }
+        });
+#pragma omp barrier
+    });
+}
+
+GKO_INSTANTIATE_FOR_EACH_VALUE_TYPE(GKO_DECLARE_CG_STEP_1_DEFLATED_KERNEL);
+
+
+template <typename StorageType, typename ValueType>
+void step_1_mixed(std::shared_ptr<const DefaultExecutor> exec,
+                  matrix::Dense<StorageType>* p,
+                  const matrix::Dense<StorageType>* z,
+                  const matrix::Dense<ValueType>* rho,
+                  const matrix::Dense<ValueType>* prev_rho,
+                  const array<stopping_status>* stop_status)
+{
+    const auto num_rows = p->get_size()[0];
+    const auto num_cols = p->get_size()[1];
+    column_buffer<size_type> active_cols{exec, num_cols};
+    const auto cols = active_cols.get_data();
+    const auto num_active = compact_active_columns(stop_status, num_cols, cols);
+    const auto row_block_size = get_row_block_size(p);
+    run_on_team([&] {
+        for_each_tile(num_rows, num_active, row_block_size, [&](span rows,
+                                                                span active) {
+            for (auto k = active.begin; k < active.end; ++k) {
+                const auto j = cols[k];
+                const auto beta = safe_divide(rho->at(j), prev_rho->at(j));
+#pragma omp simd
+                for (auto i = rows.begin; i < rows.end; ++i) {
+                    p->at(i, j) = static_cast<StorageType>(
+                        static_cast<ValueType>(z->at(i, j)) +
+                        beta * static_cast<ValueType>(p->at(i, j)));
+                }
+            }
+        });
+#pragma omp barrier
+    });
+}
+
+GKO_INSTANTIATE_FOR_EACH_VALUE_CONVERSION(GKO_DECLARE_CG_STEP_1_MIXED_KERNEL);
+
+
+template <typename StorageType, typename ValueType>
+void step_2_mixed(std::shared_ptr<const DefaultExecutor> exec,
+                  matrix::Dense<ValueType>* x, matrix::Dense<ValueType>* r,
+                  const matrix::Dense<StorageType>* p,
+                  const matrix::Dense<StorageType>* q,
+                  const matrix::Dense<ValueType>* beta,
+                  const matrix::Dense<ValueType>* rho,
+                  const array<stopping_status>* stop_status)
+{
+    const auto num_rows = x->get_size()[0];
+    const auto num_cols = x->get_size()[1];
+    column_buffer<size_type> active_cols{exec, num_cols};
+    const auto cols = active_cols.get_data();
+    const auto num_active = compact_active_columns(stop_status, num_cols, cols);
+    const auto row_block_size = get_row_block_size(x);
+    run_on_team([&] {
+        for_each_tile(num_rows, num_active, row_block_size, [&](span rows,
+                                                                span active) {
+            for (auto k = active.begin; k < active.end; ++k) {
+                const auto j = cols[k];
+                const auto step = safe_divide(rho->at(j), beta->at(j));
+#pragma omp simd
+                for (auto i = rows.begin; i < rows.end; ++i) {
+                    x->at(i, j) += step * static_cast<ValueType>(p->at(i, j));
+                    r->at(i, j) -= step * static_cast<ValueType>(q->at(i, j));
+                }
+            }
+        });
+#pragma omp barrier
+    });
+}
+
+GKO_INSTANTIATE_FOR_EACH_VALUE_CONVERSION(GKO_DECLARE_CG_STEP_2_MIXED_KERNEL);
 
 
 }  // namespace cg
@@ -0,0 +1,170 @@
+/*******************************<GINKGO LICENSE>******************************
+Copyright (c) 2017-2023, the Ginkgo authors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************<GINKGO LICENSE>*******************************/
+
+#include "omp/base/column_reduction.hpp"
+
+
+#include <memory>
+#include <random>
+
+
+#include <omp.h>
+
+
+#include <gtest/gtest.h>
+
+
+#include <ginkgo/core/base/array.hpp>
+#include <ginkgo/core/base/executor.hpp>
+#include <ginkgo/core/matrix/dense.hpp>
+
+
+#include "core/matrix/dense_kernels.hpp"
+#include "core/test/utils.hpp"
+
+
+namespace {
+
+
+class ColumnReduction : public ::testing::Test {
+protected:
+    using value_type = double;
+    using Mtx = gko::matrix::Dense<value_type>;
+
+    ColumnReduction()
+        : exec(gko::OmpExecutor::create()),
+          rand_engine(42),
+          max_threads(omp_get_max_threads()),
+          x(gen_mtx(10007, 3)),
+          y(gen_mtx(10007, 3))
+    {}
+
+    ~ColumnReduction() { omp_set_num_threads(max_threads); }
+
+    std::unique_ptr<Mtx> gen_mtx(gko::size_type num_rows,
+                                 gko::size_type num_cols)
+    {
+        return gko::test::generate_random_matrix<Mtx>(
+            num_rows, num_cols,
+            std::uniform_int_distribution<>(num_cols, num_cols),
+            std::normal_distribution<value_type>(-1.0, 1.0), rand_engine,
+            exec);
+    }
+
+    /**
+     * Calls `reduce` with 1, 2, 3, 4 and 7 threads and checks that all of
+     * them produce the same bits.
+     */
+    template <typename Reduction>
+    void assert_independent_of_num_threads(Reduction reduce)
+    {
+        auto expected = Mtx::create(exec, gko::dim<2>{1, x->get_size()[1]});
+        omp_set_num_threads(1);
+        reduce(expected.get());
+        for (auto num_threads : {2, 3, 4, 7}) {
+            SCOPED_TRACE(num_threads);
+            auto result = Mtx::create(exec, expected->get_size());
+            omp_set_num_threads(num_threads);
+            reduce(result.get());
+
+            GKO_ASSERT_MTX_NEAR(result, expected, 0.0);
+        }
+    }
+
+    std::shared_ptr<gko::OmpExecutor> exec;
+    std::default_random_engine rand_engine;
+    int max_threads;
+    std::unique_ptr<Mtx> x;
+    std::unique_ptr<Mtx> y;
+};
+
+
+TEST_F(ColumnReduction, ReproducibleSumIsIndependentOfNumThreads)
+{
+    assert_independent_of_num_threads([&](Mtx* result) {
+        gko::array<char> tmp{exec};
+        gko::kernels::omp::reduce_columns_reproducible(
+            x->get_size(), result, tmp,
+            [&](gko::size_type i, gko::size_type j) {
+                return x->at(i, j) * y->at(i, j);
+            },
+            [](value_type val) { return val; });
+    });
+}
+
+
+TEST_F(ColumnReduction, FastSumMatchesReproducibleSum)
+{
+    auto expected = Mtx::create(exec, gko::dim<2>{1, x->get_size()[1]});
+    auto result = Mtx::create(exec, expected->get_size());
+    gko::array<char> tmp{exec};
+    const auto op = [&](gko::size_type i, gko::size_type j) {
+        return x->at(i, j) * y->at(i, j);
+    };
+    const auto finalize = [](value_type val) { return val; };
+
+    gko::kernels::omp::reduce_columns_reproducible(x->get_size(),
+                                                   expected.get(), tmp, op,
+                                                   finalize);
+    gko::kernels::omp::reduce_columns_fast(x->get_size(), 256, result.get(),
+                                           tmp, op, finalize);
+
+    GKO_ASSERT_MTX_NEAR(result, expected, r<value_type>::value);
+}
+
+
+#ifdef GKO_OMP_REPRODUCIBLE_REDUCTIONS
+
+
+TEST_F(ColumnReduction, ComputeDotIsIndependentOfNumThreads)
+{
+    assert_independent_of_num_threads([&](Mtx* result) {
+        gko::array<char> tmp{exec};
+        gko::kernels::omp::dense::compute_dot(exec, x.get(), y.get(), result,
+                                              tmp);
+    });
+}
+
+
+TEST_F(ColumnReduction, ComputeNorm2IsIndependentOfNumThreads)
+{
+    assert_independent_of_num_threads([&](Mtx* result) {
+        gko::array<char> tmp{exec};
+        gko::kernels::omp::dense::compute_norm2(exec, x.get(), result, tmp);
+    });
+}
+
+
+#endif  // GKO_OMP_REPRODUCIBLE_REDUCTIONS
+
+
+}  // namespace
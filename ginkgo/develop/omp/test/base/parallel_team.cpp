@@ -0,0 +1,216 @@
+/*******************************<GINKGO LICENSE>******************************
+Copyright (c) 2017-2023, the Ginkgo authors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************<GINKGO LICENSE>*******************************/
+
+#include "omp/base/parallel_team.hpp"
+
+
+#include <memory>
+#include <random>
+#include <vector>
+
+
+#include <omp.h>
+
+
+#include <gtest/gtest.h>
+
+
+#include <ginkgo/core/base/array.hpp>
+#include <ginkgo/core/base/executor.hpp>
+#include <ginkgo/core/matrix/dense.hpp>
+
+
+#include "core/matrix/dense_kernels.hpp"
+#include "core/test/utils.hpp"
+
+
+namespace {
+
+
+class ParallelTeam : public ::testing::Test {
+protected:
+    using value_type = double;
+    using Mtx = gko::matrix::Dense<value_type>;
+
+    ParallelTeam()
+        : exec(gko::OmpExecutor::create()), rand_engine(42), num_threads(4)
+    {}
+
+    std::unique_ptr<Mtx> gen_mtx(gko::size_type num_rows,
+                                 gko::size_type num_cols)
+    {
+        return gko::test::generate_random_matrix<Mtx>(
+            num_rows, num_cols,
+            std::uniform_int_distribution<>(num_cols, num_cols),
+            std::normal_distribution<value_type>(-1.0, 1.0), rand_engine,
+            exec);
+    }
+
+    std::shared_ptr<gko::OmpExecutor> exec;
+    std::default_random_engine rand_engine;
+    int num_threads;
+};
+
+
+TEST_F(ParallelTeam, KernelsCalledFromThreadsOfCallerRegionAreIndependent)
+{
+    auto alpha = gko::initialize<Mtx>({0.5}, exec);
+    std::vector<std::unique_ptr<Mtx>> x;
+    std::vector<std::unique_ptr<Mtx>> y;
+    std::vector<std::unique_ptr<Mtx>> dot;
+    std::vector<std::unique_ptr<Mtx>> expected_y;
+    std::vector<std::unique_ptr<Mtx>> expected_dot;
+    for (int t = 0; t < num_threads; ++t) {
+        x.push_back(gen_mtx(1000, 3));
+        y.push_back(gen_mtx(1000, 3));
+        dot.push_back(Mtx::create(exec, gko::dim<2>{1, 3}));
+        expected_y.push_back(gko::clone(y.back()));
+        expected_dot.push_back(Mtx::create(exec, gko::dim<2>{1, 3}));
+        gko::array<char> tmp{exec};
+        gko::kernels::omp::dense::add_scaled(exec, alpha.get(), x[t].get(),
+                                             expected_y[t].get());
+        gko::kernels::omp::dense::compute_dot(exec, x[t].get(),
+                                              expected_y[t].get(),
+                                              expected_dot[t].get(), tmp);
+    }
+
+#pragma omp parallel num_threads(num_threads)
+    for (auto t = omp_get_thread_num(); t < num_threads;
+         t += omp_get_num_threads()) {
+        gko::array<char> tmp{exec};
+        gko::kernels::omp::dense::add_scaled(exec, alpha.get(), x[t].get(),
+                                             y[t].get());
+        gko::kernels::omp::dense::compute_dot(exec, x[t].get(), y[t].get(),
+                                              dot[t].get(), tmp);
+    }
+
+    for (int t = 0; t < num_threads; ++t) {
+        GKO_ASSERT_MTX_NEAR(y[t], expected_y[t], 0.0);
+        GKO_ASSERT_MTX_NEAR(dot[t], expected_dot[t], r<value_type>::value);
+    }
+}
+
+
+TEST_F(ParallelTeam, KernelCalledFromSingleConstructOfCallerRegionCompletes)
+{
+    auto mtx = gen_mtx(1000, 2);
+    auto expected = gko::clone(mtx);
+    expected->fill(2.0);
+
+#pragma omp parallel num_threads(num_threads)
+    {
+#pragma omp single
+        gko::kernels::omp::dense::fill(exec, mtx.get(), 2.0);
+    }
+
+    GKO_ASSERT_MTX_NEAR(mtx, expected, 0.0);
+}
+
+
+TEST_F(ParallelTeam, KernelsJoinTeamOfRegionWithGuard)
+{
+    auto alpha = gko::initialize<Mtx>({0.5}, exec);
+    auto x = gen_mtx(1000, 3);
+    auto y = gen_mtx(1000, 3);
+    auto dot = Mtx::create(exec, gko::dim<2>{1, 3});
+    auto expected_y = gko::clone(y);
+    auto expected_dot = Mtx::create(exec, gko::dim<2>{1, 3});
+    gko::array<char> tmp{exec};
+    gko::kernels::omp::dense::add_scaled(exec, alpha.get(), x.get(),
+                                         expected_y.get());
+    gko::kernels::omp::dense::compute_dot(exec, x.get(), expected_y.get(),
+                                          expected_dot.get(), tmp);
+
+#pragma omp parallel num_threads(num_threads)
+    {
+        gko::kernels::omp::team_execution_guard guard;
+        gko::kernels::omp::dense::add_scaled(exec, alpha.get(), x.get(),
+                                             y.get());
+        gko::kernels::omp::dense::compute_dot(exec, x.get(), y.get(),
+                                              dot.get(), tmp);
+    }
+
+    GKO_ASSERT_MTX_NEAR(y, expected_y, 0.0);
+    GKO_ASSERT_MTX_NEAR(dot, expected_dot, r<value_type>::value);
+}
+
+
+TEST_F(ParallelTeam, ApplyJoinsTeamOfRegionWithGuard)
+{
+    auto alpha = gko::initialize<Mtx>({0.5}, exec);
+    auto beta = gko::initialize<Mtx>({-1.5}, exec);
+    // large enough for packed_gemm outside of a guard
+    auto a = gen_mtx(100, 80);
+    auto b = gen_mtx(80, 40);
+    auto c = gen_mtx(100, 40);
+    auto simple_c = gko::clone(c);
+    auto expected_c = gko::clone(c);
+    auto expected_simple_c = gko::clone(c);
+    gko::kernels::omp::dense::apply(exec, alpha.get(), a.get(), b.get(),
+                                    beta.get(), expected_c.get());
+    gko::kernels::omp::dense::simple_apply(exec, a.get(), b.get(),
+                                           expected_simple_c.get());
+
+#pragma omp parallel num_threads(num_threads)
+    {
+        gko::kernels::omp::team_execution_guard guard;
+        gko::kernels::omp::dense::apply(exec, alpha.get(), a.get(), b.get(),
+                                        beta.get(), c.get());
+        gko::kernels::omp::dense::simple_apply(exec, a.get(), b.get(),
+                                               simple_c.get());
+    }
+
+    GKO_ASSERT_MTX_NEAR(c, expected_c, r<value_type>::value);
+    GKO_ASSERT_MTX_NEAR(simple_c, expected_simple_c, r<value_type>::value);
+}
+
+
+TEST_F(ParallelTeam, GuardOnlyAppliesWhileAlive)
+{
+    auto mtx = gen_mtx(1000, 2);
+    auto expected = gko::clone(mtx);
+    expected->fill(3.0);
+
+#pragma omp parallel num_threads(num_threads)
+    {
+        {
+            gko::kernels::omp::team_execution_guard guard;
+        }
+#pragma omp single
+        gko::kernels::omp::dense::fill(exec, mtx.get(), 3.0);
+    }
+
+    GKO_ASSERT_MTX_NEAR(mtx, expected, 0.0);
+}
+
+
+}  // namespace
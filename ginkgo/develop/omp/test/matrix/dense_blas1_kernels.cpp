@@ -0,0 +1,210 @@
+/*******************************<GINKGO LICENSE>******************************
+Copyright (c) 2017-2023, the Ginkgo authors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************<GINKGO LICENSE>*******************************/
+
+#include <memory>
+#include <random>
+
+
+#include <gtest/gtest.h>
+
+
+#include <ginkgo/core/base/executor.hpp>
+#include <ginkgo/core/matrix/dense.hpp>
+
+
+#include "core/matrix/dense_kernels.hpp"
+#include "core/test/utils.hpp"
+
+
+namespace {
+
+
+template <typename T>
+class DenseBlas1 : public ::testing::Test {
+protected:
+    using value_type = T;
+    using Mtx = gko::matrix::Dense<value_type>;
+
+    DenseBlas1()
+        : ref(gko::ReferenceExecutor::create()),
+          omp(gko::OmpExecutor::create()),
+          rand_engine(15)
+    {}
+
+    std::unique_ptr<Mtx> gen_mtx(gko::size_type num_rows,
+                                 gko::size_type num_cols)
+    {
+        return gko::test::generate_random_matrix<Mtx>(
+            num_rows, num_cols,
+            std::uniform_int_distribution<>(num_cols, num_cols),
+            std::normal_distribution<gko::remove_complex<value_type>>(0.0,
+                                                                      1.0),
+            rand_engine, ref);
+    }
+
+    void set_up_vectors(gko::size_type num_rows, gko::size_type num_cols)
+    {
+        x = gen_mtx(num_rows, num_cols);
+        y = gen_mtx(num_rows, num_cols);
+        alpha = gen_mtx(1, 1);
+        dx = gko::clone(omp, x);
+        dy = gko::clone(omp, y);
+        dalpha = gko::clone(omp, alpha);
+    }
+
+    /**
+     * Sets up copies of dx and dy with padded rows, for which the kernels use
+     * a row-wise loop instead of the loop over the contiguous values.
+     */
+    void set_up_padded_vectors()
+    {
+        dx_padded = Mtx::create(omp, dx->get_size(), dx->get_size()[1] + 2);
+        dy_padded = Mtx::create(omp, dy->get_size(), dy->get_size()[1] + 3);
+        dx_padded->copy_from(dx.get());
+        dy_padded->copy_from(dy.get());
+    }
+
+    std::shared_ptr<gko::ReferenceExecutor> ref;
+    std::shared_ptr<gko::OmpExecutor> omp;
+    std::default_random_engine rand_engine;
+    std::unique_ptr<Mtx> x;
+    std::unique_ptr<Mtx> y;
+    std::unique_ptr<Mtx> alpha;
+    std::unique_ptr<Mtx> dx;
+    std::unique_ptr<Mtx> dy;
+    std::unique_ptr<Mtx> dalpha;
+    std::unique_ptr<Mtx> dx_padded;
+    std::unique_ptr<Mtx> dy_padded;
+};
+
+TYPED_TEST_SUITE(DenseBlas1, gko::test::ValueTypes, TypenameNameGenerator);
+
+
+TYPED_TEST(DenseBlas1, AddScaledMatchesReference)
+{
+    using value_type = typename TestFixture::value_type;
+    this->set_up_vectors(1001, 3);
+
+    gko::kernels::reference::dense::add_scaled(
+        this->ref, this->alpha.get(), this->x.get(), this->y.get());
+    gko::kernels::omp::dense::add_scaled(this->omp, this->dalpha.get(),
+                                         this->dx.get(), this->dy.get());
+
+    GKO_ASSERT_MTX_NEAR(this->dy, this->y, r<value_type>::value);
+}
+
+
+TYPED_TEST(DenseBlas1, SubScaledMatchesReference)
+{
+    using value_type = typename TestFixture::value_type;
+    this->set_up_vectors(1001, 3);
+
+    gko::kernels::reference::dense::sub_scaled(
+        this->ref, this->alpha.get(), this->x.get(), this->y.get());
+    gko::kernels::omp::dense::sub_scaled(this->omp, this->dalpha.get(),
+                                         this->dx.get(), this->dy.get());
+
+    GKO_ASSERT_MTX_NEAR(this->dy, this->y, r<value_type>::value);
+}
+
+
+TYPED_TEST(DenseBlas1, ScaleMatchesReference)
+{
+    this->set_up_vectors(1001, 3);
+
+    gko::kernels::reference::dense::scale(this->ref, this->alpha.get(),
+                                          this->y.get());
+    gko::kernels::omp::dense::scale(this->omp, this->dalpha.get(),
+                                    this->dy.get());
+
+    GKO_ASSERT_MTX_NEAR(this->dy, this->y, 0.0);
+}
+
+
+TYPED_TEST(DenseBlas1, InvScaleMatchesReference)
+{
+    this->set_up_vectors(1001, 3);
+
+    gko::kernels::reference::dense::inv_scale(this->ref, this->alpha.get(),
+                                              this->y.get());
+    gko::kernels::omp::dense::inv_scale(this->omp, this->dalpha.get(),
+                                        this->dy.get());
+
+    GKO_ASSERT_MTX_NEAR(this->dy, this->y, 0.0);
+}
+
+
+TYPED_TEST(DenseBlas1, AddScaledOnPaddedMatchesContiguous)
+{
+    this->set_up_vectors(1001, 3);
+    this->set_up_padded_vectors();
+
+    gko::kernels::omp::dense::add_scaled(this->omp, this->dalpha.get(),
+                                         this->dx.get(), this->dy.get());
+    gko::kernels::omp::dense::add_scaled(this->omp, this->dalpha.get(),
+                                         this->dx_padded.get(),
+                                         this->dy_padded.get());
+
+    GKO_ASSERT_MTX_NEAR(this->dy_padded, this->dy, 0.0);
+}
+
+
+TYPED_TEST(DenseBlas1, SubScaledOnPaddedMatchesContiguous)
+{
+    this->set_up_vectors(1001, 3);
+    this->set_up_padded_vectors();
+
+    gko::kernels::omp::dense::sub_scaled(this->omp, this->dalpha.get(),
+                                         this->dx.get(), this->dy.get());
+    gko::kernels::omp::dense::sub_scaled(this->omp, this->dalpha.get(),
+                                         this->dx_padded.get(),
+                                         this->dy_padded.get());
+
+    GKO_ASSERT_MTX_NEAR(this->dy_padded, this->dy, 0.0);
+}
+
+
+TYPED_TEST(DenseBlas1, ScaleOnPaddedMatchesContiguous)
+{
+    this->set_up_vectors(1001, 3);
+    this->set_up_padded_vectors();
+
+    gko::kernels::omp::dense::scale(this->omp, this->dalpha.get(),
+                                    this->dy.get());
+    gko::kernels::omp::dense::scale(this->omp, this->dalpha.get(),
+                                    this->dy_padded.get());
+
+    GKO_ASSERT_MTX_NEAR(this->dy_padded, this->dy, 0.0);
+}
+
+
+}  // namespace
@@ -0,0 +1,242 @@
+/*******************************<GINKGO LICENSE>******************************
+Copyright (c) 2017-2023, the Ginkgo authors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************<GINKGO LICENSE>*******************************/
+
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <vector>
+
+
+#include <omp.h>
+
+
+#include <gtest/gtest.h>
+
+
+#include <ginkgo/core/base/executor.hpp>
+#include <ginkgo/core/matrix/dense.hpp>
+
+
+#include "core/matrix/dense_kernels.hpp"
+#include "core/test/utils.hpp"
+
+
+namespace {
+
+
+template <typename T>
+class DenseGemm : public ::testing::Test {
+protected:
+    using value_type = T;
+    using Mtx = gko::matrix::Dense<value_type>;
+
+    DenseGemm()
+        : ref(gko::ReferenceExecutor::create()),
+          omp(gko::OmpExecutor::create()),
+          rand_engine(42)
+    {}
+
+    std::unique_ptr<Mtx> gen_mtx(std::shared_ptr<const gko::Executor> exec,
+                                 gko::size_type num_rows,
+                                 gko::size_type num_cols,
+                                 gko::size_type stride)
+    {
+        auto tmp_mtx = gko::test::generate_random_matrix<Mtx>(
+            num_rows, num_cols,
+            std::uniform_int_distribution<>(num_cols, num_cols),
+            std::normal_distribution<gko::remove_complex<value_type>>(0.0,
+                                                                      1.0),
+            rand_engine, ref);
+        auto result =
+            Mtx::create(exec, gko::dim<2>{num_rows, num_cols}, stride);
+        result->copy_from(tmp_mtx.get());
+        return result;
+    }
+
+    /**
+     * Sets up the operands of C = A * B with padded strides on both
+     * executors.
+     */
+    void set_up_product(gko::size_type num_rows, gko::size_type num_inner,
+                        gko::size_type num_cols)
+    {
+        a = gen_mtx(ref, num_rows, num_inner, num_inner + 3);
+        b = gen_mtx(ref, num_inner, num_cols, num_cols + 1);
+        c = gen_mtx(ref, num_rows, num_cols, num_cols + 5);
+        alpha = gen_mtx(ref, 1, 1, 1);
+        beta = gen_mtx(ref, 1, 1, 1);
+        da = Mtx::create(omp, a->get_size(), a->get_stride());
+        db = Mtx::create(omp, b->get_size(), b->get_stride());
+        dc = Mtx::create(omp, c->get_size(), c->get_stride());
+        da->copy_from(a.get());
+        db->copy_from(b.get());
+        dc->copy_from(c.get());
+        dalpha = gko::clone(omp, alpha);
+        dbeta = gko::clone(omp, beta);
+    }
+
+    /**
+     * Shapes around the blocking parameters of the packed product: row counts
+     * that are not multiples of gemm_mr or gemm_mc, inner dimensions that are
+     * not multiples of gemm_kc and column counts that are not multiples of
+     * gemm_nr or gemm_nc, so every packing routine has to handle a partial
+     * block.
+     */
+    static std::vector<gko::dim<3>> edge_shapes()
+    {
+        return {{5, 37, 67},    {97, 257, 19}, {301, 513, 37},
+                {4, 8, 1031},   {193, 255, 9}, {13, 1, 40},
+                {103, 300, 131}};
+    }
+
+    std::shared_ptr<gko::ReferenceExecutor> ref;
+    std::shared_ptr<gko::OmpExecutor> omp;
+    std::default_random_engine rand_engine;
+    std::unique_ptr<Mtx> a;
+    std::unique_ptr<Mtx> b;
+    std::unique_ptr<Mtx> c;
+    std::unique_ptr<Mtx> alpha;
+    std::unique_ptr<Mtx> beta;
+    std::unique_ptr<Mtx> da;
+    std::unique_ptr<Mtx> db;
+    std::unique_ptr<Mtx> dc;
+    std::unique_ptr<Mtx> dalpha;
+    std::unique_ptr<Mtx> dbeta;
+};
+
+TYPED_TEST_SUITE(DenseGemm, gko::test::ValueTypes, TypenameNameGenerator);
+
+
+TYPED_TEST(DenseGemm, SimpleApplyWithEdgeShapesMatchesReference)
+{
+    using value_type = typename TestFixture::value_type;
+    for (const auto shape : this->edge_shapes()) {
+        SCOPED_TRACE(shape);
+        this->set_up_product(shape[0], shape[1], shape[2]);
+
+        gko::kernels::reference::dense::simple_apply(
+            this->ref, this->a.get(), this->b.get(), this->c.get());
+        gko::kernels::omp::dense::simple_apply(
+            this->omp, this->da.get(), this->db.get(), this->dc.get());
+
+        GKO_ASSERT_MTX_NEAR(this->dc, this->c, r<value_type>::value);
+    }
+}
+
+
+TYPED_TEST(DenseGemm, ApplyWithEdgeShapesMatchesReference)
+{
+    using value_type = typename TestFixture::value_type;
+    for (const auto shape : this->edge_shapes()) {
+        SCOPED_TRACE(shape);
+        this->set_up_product(shape[0], shape[1], shape[2]);
+
+        gko::kernels::reference::dense::apply(
+            this->ref, this->alpha.get(), this->a.get(), this->b.get(),
+            this->beta.get(), this->c.get());
+        gko::kernels::omp::dense::apply(this->omp, this->dalpha.get(),
+                                        this->da.get(), this->db.get(),
+                                        this->dbeta.get(), this->dc.get());
+
+        GKO_ASSERT_MTX_NEAR(this->dc, this->c, r<value_type>::value);
+    }
+}
+
+
+TYPED_TEST(DenseGemm, SimpleApplyWithLongInnerDimensionMatchesReference)
+{
+    using value_type = typename TestFixture::value_type;
+    // products with at most 1024 outputs split an inner dimension of at least
+    // 256 values per thread among the threads
+    const gko::size_type num_inner = omp_get_max_threads() * 256 + 17;
+    for (const auto shape : {gko::dim<2>{1, 1}, gko::dim<2>{3, 5},
+                             gko::dim<2>{16, 64}}) {
+        SCOPED_TRACE(shape);
+        this->set_up_product(shape[0], num_inner, shape[1]);
+
+        gko::kernels::reference::dense::simple_apply(
+            this->ref, this->a.get(), this->b.get(), this->c.get());
+        gko::kernels::omp::dense::simple_apply(
+            this->omp, this->da.get(), this->db.get(), this->dc.get());
+
+        GKO_ASSERT_MTX_NEAR(this->dc, this->c, r<value_type>::value);
+    }
+}
+
+
+TYPED_TEST(DenseGemm, ApplyWithLongInnerDimensionMatchesReference)
+{
+    using value_type = typename TestFixture::value_type;
+    const gko::size_type num_inner = omp_get_max_threads() * 256 + 17;
+    for (const auto shape : {gko::dim<2>{1, 1}, gko::dim<2>{3, 5},
+                             gko::dim<2>{16, 64}}) {
+        SCOPED_TRACE(shape);
+        this->set_up_product(shape[0], num_inner, shape[1]);
+
+        gko::kernels::reference::dense::apply(
+            this->ref, this->alpha.get(), this->a.get(), this->b.get(),
+            this->beta.get(), this->c.get());
+        gko::kernels::omp::dense::apply(this->omp, this->dalpha.get(),
+                                        this->da.get(), this->db.get(),
+                                        this->dbeta.get(), this->dc.get());
+
+        GKO_ASSERT_MTX_NEAR(this->dc, this->c, r<value_type>::value);
+    }
+}
+
+
+TYPED_TEST(DenseGemm, ApplyLeavesPaddingUntouched)
+{
+    using value_type = typename TestFixture::value_type;
+    this->set_up_product(97, 257, 19);
+    const auto num_cols = this->dc->get_size()[1];
+    const auto stride = this->dc->get_stride();
+    const auto padding = static_cast<value_type>(123.0);
+    const auto values = this->dc->get_values();
+    for (gko::size_type row = 0; row < this->dc->get_size()[0]; ++row) {
+        std::fill(values + row * stride + num_cols, values + (row + 1) * stride,
+                  padding);
+    }
+
+    gko::kernels::omp::dense::apply(this->omp, this->dalpha.get(),
+                                    this->da.get(), this->db.get(),
+                                    this->dbeta.get(), this->dc.get());
+
+    for (gko::size_type row = 0; row < this->dc->get_size()[0]; ++row) {
+        for (auto col = num_cols; col < stride; ++col) {
+            ASSERT_EQ(values[row * stride + col], padding);
+        }
+    }
+}
+
+
+}  // namespace
@@ -53,6 +53,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "accessor/range.hpp"
 #include "core/base/mixed_precision_types.hpp"
 #include "core/components/prefix_sum_kernels.hpp"
+#include "core/matrix/dense_fused_kernels.hpp"
 
 
 namespace gko {
@@ -315,6 +316,21 @@ GKO_INSTANTIATE_FOR_EACH_VALUE_AND_SCALAR_TYPE(
     GKO_DECLARE_DENSE_ADD_SCALED_KERNEL);
 
 
+template <typename ValueType, typename ScalarType>
+void scale_add_scaled(std::shared_ptr<const DefaultExecutor> exec,
+                      const matrix::Dense<ScalarType>* beta,
+                      const matrix::Dense<ScalarType>* alpha,
+                      const matrix::Dense<ValueType>* x,
+                      matrix::Dense<ValueType>* y)
+{
+    scale(exec, beta, y);
+    add_scaled(exec, alpha, x, y);
+}
+
+GKO_INSTANTIATE_FOR_EACH_VALUE_AND_SCALAR_TYPE(
+    GKO_DECLARE_DENSE_SCALE_ADD_SCALED_KERNEL);
+
+
 template <typename ValueType, typename ScalarType>
 void sub_scaled(std::shared_ptr<const DefaultExecutor> exec,
                 const matrix::Dense<ScalarType>* alpha,
@@ -470,6 +486,26 @@ GKO_INSTANTIATE_FOR_EACH_VALUE_TYPE(
     GKO_DECLARE_DENSE_COMPUTE_CONJ_DOT_DISPATCH_KERNEL);
 
 
+template <typename ValueType>
+void compute_multi_conj_dot(std::shared_ptr<const DefaultExecutor> exec,
+                            const matrix::Dense<ValueType>* x,
+                            const matrix::Dense<ValueType>* y,
+                            matrix::Dense<ValueType>* result, array<char>&)
+{
+    const auto num_cols = x->get_size()[1];
+    for (size_type j = 0; j < y->get_size()[1]; ++j) {
+        auto val = zero<ValueType>();
+        for (size_type i = 0; i < x->get_size()[0]; ++i) {
+            val += conj(x->at(i, j % num_cols)) * y->at(i, j);
+        }
+        result->at(0, j) = val;
+    }
+}
+
+GKO_INSTANTIATE_FOR_EACH_VALUE_TYPE(
+    GKO_DECLARE_DENSE_COMPUTE_MULTI_CONJ_DOT_KERNEL);
+
+
 template <typename ValueType>
 void compute_norm2(std::shared_ptr<const DefaultExecutor> exec,
                    const matrix::Dense<ValueType>* x,
@@ -152,6 +152,231 @@ void step_2(std::shared_ptr<const DefaultExecutor> exec,
 GKO_INSTANTIATE_FOR_EACH_VALUE_TYPE(GKO_DECLARE_CG_STEP_2_KERNEL);
 
 
+template <typename ValueType>
+void step_2_fused(std::shared_ptr<const DefaultExecutor> exec,
+                  matrix::Dense<ValueType>* x, matrix::Dense<ValueType>* r,
+                  const matrix::Dense<ValueType>* p,
+                  const matrix::Dense<ValueType>* q,
+                  const matrix::Dense<ValueType>* beta,
+                  matrix::Dense<ValueType>* prev_rho,
+                  matrix::Dense<ValueType>* rho, array<char>& tmp,
+                  const array<stopping_status>* stop_status)
+{
+    step_2(exec, x, r, p, q, beta, rho, stop_status);
+    for (size_type j = 0; j < x->get_size()[1]; ++j) {
+        prev_rho->at(j) = rho->at(j);
+        rho->at(j) = zero<ValueType>();
+    }
+    for (size_type i = 0; i < x->get_size()[0]; ++i) {
+        for (size_type j = 0; j < x->get_size()[1]; ++j) {
+            rho->at(j) += conj(r->at(i, j)) * r->at(i, j);
+        }
+    }
+}
+
+GKO_INSTANTIATE_FOR_EACH_VALUE_TYPE(GKO_DECLARE_CG_STEP_2_FUSED_KERNEL);
+
+
+template <typename ValueType>
+void step_2_jacobi(std::shared_ptr<const DefaultExecutor> exec,
+                   matrix::Dense<ValueType>* x, matrix::Dense<ValueType>* r,
+                   matrix::Dense<ValueType>* z,
+                   const matrix::Dense<ValueType>* p,
+                   const matrix::Dense<ValueType>* q,
+                   const matrix::Diagonal<ValueType>* inv_diag,
+                   const matrix::Dense<ValueType>* beta,
+                   matrix::Dense<ValueType>* prev_rho,
+                   matrix::Dense<ValueType>* rho, array<char>& tmp,
+                   const array<stopping_status>* stop_status)
+{
+    step_2(exec, x, r, p, q, beta, rho, stop_status);
+    const auto diag = inv_diag->get_const_values();
+    for (size_type i = 0; i < x->get_size()[0]; ++i) {
+        for (size_type j = 0; j < x->get_size()[1]; ++j) {
+            z->at(i, j) = diag[i] * r->at(i, j);
+        }
+    }
+    for (size_type j = 0; j < x->get_size()[1]; ++j) {
+        prev_rho->at(j) = rho->at(j);
+        rho->at(j) = zero<ValueType>();
+    }
+    for (size_type i = 0; i < x->get_size()[0]; ++i) {
+        for (size_type j = 0; j < x->get_size()[1]; ++j) {
+            rho->at(j) += conj(r->at(i, j)) * z->at(i, j);
+        }
+    }
+}
+
+GKO_INSTANTIATE_FOR_EACH_VALUE_TYPE(GKO_DECLARE_CG_STEP_2_JACOBI_KERNEL);
+
+
+template <typename ValueType>
+void initialize_pipelined(std::shared_ptr<const DefaultExecutor> exec,
+                          const matrix::Dense<ValueType>* b,
+                          matrix::Dense<ValueType>* r,
+                          matrix::Dense<ValueType>* p,
+                          matrix::Dense<ValueType>* q,
+                          matrix::Dense<ValueType>* s,
+                          matrix::Dense<ValueType>* z,
+                          matrix::Dense<ValueType>* prev_rho,
+                          matrix::Dense<ValueType>* alpha,
+                          array<stopping_status>* stop_status)
+{
+    for (size_type j = 0; j < b->get_size()[1]; ++j) {
+        prev_rho->at(j) = zero<ValueType>();
+        alpha->at(j) = one<ValueType>();
+        stop_status->get_data()[j].reset();
+    }
+    for (size_type i = 0; i < b->get_size()[0]; ++i) {
+        for (size_type j = 0; j < b->get_size()[1]; ++j) {
+            r->at(i, j) = b->at(i, j);
+            p->at(i, j) = q->at(i, j) = s->at(i, j) = z->at(i, j) =
+                zero<ValueType>();
+        }
+    }
+}
+
+GKO_INSTANTIATE_FOR_EACH_VALUE_TYPE(GKO_DECLARE_CG_INITIALIZE_PIPELINED_KERNEL);
+
+
+template <typename ValueType>
+void step_1_pipelined(std::shared_ptr<const DefaultExecutor> exec,
+                      const matrix::Dense<ValueType>* r,
+                      const matrix::Dense<ValueType>* u,
+                      const matrix::Dense<ValueType>* w,
+                      matrix::Dense<ValueType>* dots, array<char>& tmp)
+{
+    const auto num_cols = r->get_size()[1];
+    for (size_type j = 0; j < 2 * num_cols; ++j) {
+        dots->at(0, j) = zero<ValueType>();
+    }
+    for (size_type i = 0; i < r->get_size()[0]; ++i) {
+        for (size_type j = 0; j < num_cols; ++j) {
+            dots->at(0, j) += conj(r->at(i, j)) * u->at(i, j);
+            dots->at(0, num_cols + j) += conj(w->at(i, j)) * u->at(i, j);
+        }
+    }
+}
+
+GKO_INSTANTIATE_FOR_EACH_VALUE_TYPE(GKO_DECLARE_CG_STEP_1_PIPELINED_KERNEL);
+
+
+template <typename ValueType>
+void step_2_pipelined(
+    std::shared_ptr<const DefaultExecutor> exec, matrix::Dense<ValueType>* x,
+    matrix::Dense<ValueType>* r, matrix::Dense<ValueType>* u,
+    matrix::Dense<ValueType>* w, matrix::Dense<ValueType>* p,
+    matrix::Dense<ValueType>* q, matrix::Dense<ValueType>* s,
+    matrix::Dense<ValueType>* z, const matrix::Dense<ValueType>* m,
+    const matrix::Dense<ValueType>* n, const matrix::Dense<ValueType>* dots,
+    matrix::Dense<ValueType>* prev_rho, matrix::Dense<ValueType>* alpha,
+    const array<stopping_status>* stop_status)
+{
+    const auto num_cols = x->get_size()[1];
+    for (size_type j = 0; j < num_cols; ++j) {
+        if (stop_status->get_const_data()[j].has_stopped()) {
+            continue;
+        }
+        const auto gamma = dots->at(0, j);
+        const auto delta = dots->at(0, num_cols + j);
+        const auto beta = safe_divide(gamma, prev_rho->at(j));
+        const auto step =
+            safe_divide(gamma, delta - safe_divide(beta * gamma, alpha->at(j)));
+        for (size_type i = 0; i < x->get_size()[0]; ++i) {
+            z->at(i, j) = n->at(i, j) + beta * z->at(i, j);
+            q->at(i, j) = m->at(i, j) + beta * q->at(i, j);
+            s->at(i, j) = w->at(i, j) + beta * s->at(i, j);
+            p->at(i, j) = u->at(i, j) + beta * p->at(i, j);
+            x->at(i, j) += step * p->at(i, j);
+            r->at(i, j) -= step * s->at(i, j);
+            u->at(i, j) -= step * q->at(i, j);
+            w->at(i, j) -= step * z->at(i, j);
+        }
+        prev_rho->at(j) = gamma;
+        alpha->at(j) = step;
+    }
+}
+
+GKO_INSTANTIATE_FOR_EACH_VALUE_TYPE(GKO_DECLARE_CG_STEP_2_PIPELINED_KERNEL);
+
+
+template <typename ValueType>
+void step_1_deflated(std::shared_ptr<const DefaultExecutor> exec,
+                     matrix::Dense<ValueType>* p,
+                     const matrix::Dense<ValueType>* z,
+                     const matrix::Dense<ValueType>* basis,
+                     const matrix::Dense<ValueType>* mu,
+                     const matrix::Dense<ValueType>* rho,
+                     const matrix::Dense<ValueType>* prev_rho,
+                     const array<stopping_status>* stop_status)
+{
+    const auto num_vectors = basis->get_size()[1];
+    for (size_type j = 0; j < p->get_size()[1]; ++j) {
+        if (stop_status->get_const_data()[j].has_stopped()) {
+            continue;
+        }
+        const auto beta = safe_divide(rho->at(j), prev_rho->at(j));
+        for (size_type i = 0; i < p->get_size()[0]; ++i) {
+            auto val = z->at(i, j) + beta * p->at(i, j);
+            for (size_type l = 0; l < num_vectors; ++l) {
+                val -= basis->at(i, l) * mu->at(l, j);
+            }
+            p->at(i, j) = val;
+        }
+    }
+}
+
+GKO_INSTANTIATE_FOR_EACH_VALUE_TYPE(GKO_DECLARE_CG_STEP_1_DEFLATED_KERNEL);
+
+
+template <typename StorageType, typename ValueType>
+void step_1_mixed(std::shared_ptr<const DefaultExecutor> exec,
+                  matrix::Dense<StorageType>* p,
+                  const matrix::Dense<StorageType>* z,
+                  const matrix::Dense<ValueType>* rho,
+                  const matrix::Dense<ValueType>* prev_rho,
+                  const array<stopping_status>* stop_status)
+{
+    for (size_type j = 0; j < p->get_size()[1]; ++j) {
+        if (stop_status->get_const_data()[j].has_stopped()) {
+            continue;
+        }
+        const auto beta = safe_divide(rho->at(j), prev_rho->at(j));
+        for (size_type i = 0; i < p->get_size()[0]; ++i) {
+            p->at(i, j) = static_cast<StorageType>(
+                static_cast<ValueType>(z->at(i, j)) +
+                beta * static_cast<ValueType>(p->at(i, j)));
+        }
+    }
+}
+
+GKO_INSTANTIATE_FOR_EACH_VALUE_CONVERSION(GKO_DECLARE_CG_STEP_1_MIXED_KERNEL);
+
+
+template <typename StorageType, typename ValueType>
+void step_2_mixed(std::shared_ptr<const DefaultExecutor> exec,
+                  matrix::Dense<ValueType>* x, matrix::Dense<ValueType>* r,
+                  const matrix::Dense<StorageType>* p,
+                  const matrix::Dense<StorageType>* q,
+                  const matrix::Dense<ValueType>* beta,
+                  const matrix::Dense<ValueType>* rho,
+                  const array<stopping_status>* stop_status)
+{
+    for (size_type j = 0; j < x->get_size()[1]; ++j) {
+        if (stop_status->get_const_data()[j].has_stopped()) {
+            continue;
+        }
+        const auto step = safe_divide(rho->at(j), beta->at(j));
+        for (size_type i = 0; i < x->get_size()[0]; ++i) {
+            x->at(i, j) += step * static_cast<ValueType>(p->at(i, j));
+            r->at(i, j) -= step * static_cast<ValueType>(q->at(i, j));
+        }
+    }
+}
+
+GKO_INSTANTIATE_FOR_EACH_VALUE_CONVERSION(GKO_DECLARE_CG_STEP_2_MIXED_KERNEL);
+
+
 }  // namespace cg
 }  // namespace reference
 }  // namespace kernels
@@ -0,0 +1,191 @@
+/*******************************<GINKGO LICENSE>******************************
+Copyright (c) 2017-2023, the Ginkgo authors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************<GINKGO LICENSE>*******************************/
+
+#include <memory>
+#include <random>
+
+
+#include <gtest/gtest.h>
+
+
+#include <ginkgo/core/base/array.hpp>
+#include <ginkgo/core/base/executor.hpp>
+#include <ginkgo/core/matrix/dense.hpp>
+
+
+#include "core/matrix/dense_fused_kernels.hpp"
+#include "core/matrix/dense_kernels.hpp"
+#include "core/test/utils.hpp"
+#include "core/test/utils/matrix_generator.hpp"
+#include "test/utils/executor.hpp"
+
+
+class DenseFused : public CommonTestFixture {
+protected:
+    using Mtx = gko::matrix::Dense<value_type>;
+
+    DenseFused() : rand_engine(15), tmp{ref}, d_tmp{exec} {}
+
+    std::unique_ptr<Mtx> gen_mtx(gko::size_type num_rows,
+                                 gko::size_type num_cols, gko::size_type stride)
+    {
+        auto tmp_mtx = gko::test::generate_random_matrix<Mtx>(
+            num_rows, num_cols,
+            std::uniform_int_distribution<>(num_cols, num_cols),
+            std::normal_distribution<value_type>(-1.0, 1.0), rand_engine, ref);
+        auto result = Mtx::create(ref, gko::dim<2>{num_rows, num_cols}, stride);
+        result->copy_from(tmp_mtx.get());
+        return result;
+    }
+
+    void initialize_data(gko::size_type m, gko::size_type n,
+                         gko::size_type num_blocks)
+    {
+        x = gen_mtx(m, n, n + 2);
+        y = gen_mtx(m, num_blocks * n, num_blocks * n + 1);
+        result = gen_mtx(1, num_blocks * n, num_blocks * n);
+        d_x = gko::clone(exec, x);
+        d_y = gko::clone(exec, y);
+        d_result = gko::clone(exec, result);
+    }
+
+    std::default_random_engine rand_engine;
+
+    std::unique_ptr<Mtx> x;
+    std::unique_ptr<Mtx> y;
+    std::unique_ptr<Mtx> result;
+    gko::array<char> tmp;
+
+    std::unique_ptr<Mtx> d_x;
+    std::unique_ptr<Mtx> d_y;
+    std::unique_ptr<Mtx> d_result;
+    gko::array<char> d_tmp;
+};
+
+
+TEST_F(DenseFused, MultiConjDotIsEquivalentToRef)
+{
+    for (auto n : {1, 4, 43}) {
+        for (auto num_blocks : {1, 3}) {
+            SCOPED_TRACE(n);
+            SCOPED_TRACE(num_blocks);
+            initialize_data(597, n, num_blocks);
+
+            gko::kernels::reference::dense::compute_multi_conj_dot(
+                ref, x.get(), y.get(), result.get(), tmp);
+            gko::kernels::EXEC_NAMESPACE::dense::compute_multi_conj_dot(
+                exec, d_x.get(), d_y.get(), d_result.get(), d_tmp);
+
+            GKO_ASSERT_MTX_NEAR(d_result, result, ::r<value_type>::value);
+        }
+    }
+}
+
+
+TEST_F(DenseFused, MultiConjDotIsEquivalentToConjDotPerBlock)
+{
+    const gko::size_type n = 4;
+    const gko::size_type num_blocks = 3;
+    initialize_data(597, n, num_blocks);
+    auto block = Mtx::create(ref, gko::dim<2>{597, n});
+    auto block_result = Mtx::create(ref, gko::dim<2>{1, n});
+
+    gko::kernels::EXEC_NAMESPACE::dense::compute_multi_conj_dot(
+        exec, d_x.get(), d_y.get(), d_result.get(), d_tmp);
+
+    for (gko::size_type b = 0; b < num_blocks; ++b) {
+        for (gko::size_type i = 0; i < block->get_size()[0]; ++i) {
+            for (gko::size_type j = 0; j < n; ++j) {
+                block->at(i, j) = y->at(i, b * n + j);
+            }
+        }
+        gko::kernels::reference::dense::compute_conj_dot(
+            ref, x.get(), block.get(), block_result.get(), tmp);
+        for (gko::size_type j = 0; j < n; ++j) {
+            result->at(0, b * n + j) = block_result->at(0, j);
+        }
+    }
+    GKO_ASSERT_MTX_NEAR(d_result, result, ::r<value_type>::value);
+}
+
+
+TEST_F(DenseFused, ScaleAddScaledIsEquivalentToRef)
+{
+    for (gko::size_type padding : {0, 3}) {
+        for (gko::size_type num_coefs : {1, 5}) {
+            SCOPED_TRACE(padding);
+            SCOPED_TRACE(num_coefs);
+            x = gen_mtx(597, 5, 5 + padding);
+            y = gen_mtx(597, 5, 5 + padding);
+            auto alpha = gen_mtx(1, num_coefs, num_coefs);
+            auto beta = gen_mtx(1, num_coefs, num_coefs);
+            if (num_coefs > 1) {
+                alpha->at(0, 1) = gko::zero<value_type>();
+                beta->at(0, 2) = gko::zero<value_type>();
+                beta->at(0, 3) = gko::one<value_type>();
+            }
+            d_x = gko::clone(exec, x);
+            d_y = gko::clone(exec, y);
+            auto d_alpha = gko::clone(exec, alpha);
+            auto d_beta = gko::clone(exec, beta);
+
+            gko::kernels::reference::dense::scale_add_scaled(
+                ref, beta.get(), alpha.get(), x.get(), y.get());
+            gko::kernels::EXEC_NAMESPACE::dense::scale_add_scaled(
+                exec, d_beta.get(), d_alpha.get(), d_x.get(), d_y.get());
+
+            GKO_ASSERT_MTX_NEAR(d_y, y, ::r<value_type>::value);
+        }
+    }
+}
+
+
+TEST_F(DenseFused, ScaleAddScaledWithZeroBetaDiscardsOldValues)
+{
+    x = gen_mtx(597, 3, 3);
+    y = gen_mtx(597, 3, 3);
+    auto alpha = gen_mtx(1, 1, 1);
+    auto beta = gen_mtx(1, 1, 1);
+    beta->at(0, 0) = gko::zero<value_type>();
+    d_x = gko::clone(exec, x);
+    d_y = gko::clone(exec, y);
+    d_y->fill(gko::nan<value_type>());
+    auto d_alpha = gko::clone(exec, alpha);
+    auto d_beta = gko::clone(exec, beta);
+
+    gko::kernels::reference::dense::scale_add_scaled(
+        ref, beta.get(), alpha.get(), x.get(), y.get());
+    gko::kernels::EXEC_NAMESPACE::dense::scale_add_scaled(
+        exec, d_beta.get(), d_alpha.get(), d_x.get(), d_y.get());
+
+    GKO_ASSERT_MTX_NEAR(d_y, y, ::r<value_type>::value);
+}
@@ -0,0 +1,201 @@
+/*******************************<GINKGO LICENSE>******************************
+Copyright (c) 2017-2023, the Ginkgo authors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************<GINKGO LICENSE>*******************************/
+
+#include <memory>
+#include <random>
+
+
+#include <gtest/gtest.h>
+
+
+#include <ginkgo/core/base/array.hpp>
+#include <ginkgo/core/base/executor.hpp>
+#include <ginkgo/core/matrix/dense.hpp>
+#include <ginkgo/core/stop/stopping_status.hpp>
+
+
+#include "core/matrix/dense_kernels.hpp"
+#include "core/solver/cg_kernels.hpp"
+#include "core/test/utils.hpp"
+#include "core/test/utils/matrix_generator.hpp"
+#include "test/utils/executor.hpp"
+
+
+class CgDeflated : public CommonTestFixture {
+protected:
+    using Mtx = gko::matrix::Dense<value_type>;
+
+    CgDeflated() : rand_engine(7) {}
+
+    std::unique_ptr<Mtx> gen_mtx(gko::size_type num_rows,
+                                 gko::size_type num_cols, gko::size_type stride)
+    {
+        auto tmp_mtx = gko::test::generate_random_matrix<Mtx>(
+            num_rows, num_cols,
+            std::uniform_int_distribution<>(num_cols, num_cols),
+            std::normal_distribution<value_type>(-1.0, 1.0), rand_engine, ref);
+        auto result = Mtx::create(ref, gko::dim<2>{num_rows, num_cols}, stride);
+        result->copy_from(tmp_mtx.get());
+        return result;
+    }
+
+    void initialize_data(gko::size_type m, gko::size_type n,
+                         gko::size_type num_vectors)
+    {
+        p = gen_mtx(m, n, n + 2);
+        z = gen_mtx(m, n, n + 1);
+        basis = gen_mtx(m, num_vectors, num_vectors + 1);
+        mu = gen_mtx(num_vectors, n, n);
+        rho = gen_mtx(1, n, n);
+        prev_rho = gen_mtx(1, n, n);
+        stop_status =
+            std::make_unique<gko::array<gko::stopping_status>>(ref, n);
+        for (gko::size_type i = 0; i < n; ++i) {
+            stop_status->get_data()[i].reset();
+        }
+        if (n > 2) {
+            // check correct handling for zero values and stopped columns
+            prev_rho->at(2) = 0.0;
+            stop_status->get_data()[1].stop(1);
+        }
+
+        d_p = gko::clone(exec, p);
+        d_z = gko::clone(exec, z);
+        d_basis = gko::clone(exec, basis);
+        d_mu = gko::clone(exec, mu);
+        d_rho = gko::clone(exec, rho);
+        d_prev_rho = gko::clone(exec, prev_rho);
+        d_stop_status = std::make_unique<gko::array<gko::stopping_status>>(
+            exec, *stop_status);
+    }
+
+    std::default_random_engine rand_engine;
+
+    std::unique_ptr<Mtx> p;
+    std::unique_ptr<Mtx> z;
+    std::unique_ptr<Mtx> basis;
+    std::unique_ptr<Mtx> mu;
+    std::unique_ptr<Mtx> rho;
+    std::unique_ptr<Mtx> prev_rho;
+    std::unique_ptr<gko::array<gko::stopping_status>> stop_status;
+
+    std::unique_ptr<Mtx> d_p;
+    std::unique_ptr<Mtx> d_z;
+    std::unique_ptr<Mtx> d_basis;
+    std::unique_ptr<Mtx> d_mu;
+    std::unique_ptr<Mtx> d_rho;
+    std::unique_ptr<Mtx> d_prev_rho;
+    std::unique_ptr<gko::array<gko::stopping_status>> d_stop_status;
+};
+
+
+TEST_F(CgDeflated, Step1DeflatedIsEquivalentToRef)
+{
+    for (gko::size_type n : {1, 4, 43}) {
+        for (gko::size_type num_vectors : {1, 8}) {
+            SCOPED_TRACE(n);
+            SCOPED_TRACE(num_vectors);
+            initialize_data(597, n, num_vectors);
+
+            gko::kernels::reference::cg::step_1_deflated(
+                ref, p.get(), z.get(), basis.get(), mu.get(), rho.get(),
+                prev_rho.get(), stop_status.get());
+            gko::kernels::EXEC_NAMESPACE::cg::step_1_deflated(
+                exec, d_p.get(), d_z.get(), d_basis.get(), d_mu.get(),
+                d_rho.get(), d_prev_rho.get(), d_stop_status.get());
+
+            GKO_ASSERT_MTX_NEAR(d_p, p, ::r<value_type>::value);
+        }
+    }
+}
+
+
+TEST_F(CgDeflated, Step1DeflatedWithEmptyBasisIsEquivalentToStep1)
+{
+    initialize_data(597, 43, 0);
+
+    gko::kernels::reference::cg::step_1(ref, p.get(), z.get(), rho.get(),
+                                        prev_rho.get(), stop_status.get());
+    gko::kernels::EXEC_NAMESPACE::cg::step_1_deflated(
+        exec, d_p.get(), d_z.get(), d_basis.get(), d_mu.get(), d_rho.get(),
+        d_prev_rho.get(), d_stop_status.get());
+
+    GKO_ASSERT_MTX_NEAR(d_p, p, ::r<value_type>::value);
+}
+
+
+TEST_F(CgDeflated, Step1DeflatedDirectionIsAOrthogonalToBasis)
+{
+    const gko::size_type size = 50;
+    // A = B^T B / size + I is well-conditioned and SPD
+    auto rand = gen_mtx(size, size, size);
+    auto mtx = Mtx::create(ref, gko::dim<2>{size, size});
+    for (gko::size_type i = 0; i < size; ++i) {
+        for (gko::size_type j = 0; j < size; ++j) {
+            mtx->at(i, j) = i == j ? 1.0 : 0.0;
+            for (gko::size_type k = 0; k < size; ++k) {
+                mtx->at(i, j) += rand->at(k, i) * rand->at(k, j) /
+                                 static_cast<value_type>(size);
+            }
+        }
+    }
+    initialize_data(size, 1, 1);
+    // the first direction has no previous direction to keep
+    d_prev_rho->fill(0.0);
+    auto mtx_basis = Mtx::create(ref, gko::dim<2>{size, 1});
+    auto projection = Mtx::create(ref, gko::dim<2>{1, 1});
+    auto coarse = Mtx::create(ref, gko::dim<2>{1, 1});
+    gko::array<char> tmp{ref};
+    gko::kernels::reference::dense::simple_apply(ref, mtx.get(), basis.get(),
+                                                 mtx_basis.get());
+    // mu = (W^H A W)^{-1} (A W)^H z for a single basis vector
+    gko::kernels::reference::dense::compute_conj_dot(
+        ref, mtx_basis.get(), z.get(), projection.get(), tmp);
+    gko::kernels::reference::dense::compute_conj_dot(
+        ref, basis.get(), mtx_basis.get(), coarse.get(), tmp);
+    mu->at(0, 0) = projection->at(0, 0) / coarse->at(0, 0);
+    d_mu = gko::clone(exec, mu);
+
+    gko::kernels::EXEC_NAMESPACE::cg::step_1_deflated(
+        exec, d_p.get(), d_z.get(), d_basis.get(), d_mu.get(), d_rho.get(),
+        d_prev_rho.get(), d_stop_status.get());
+
+    auto result = gko::clone(ref, d_p);
+    auto orthogonality = gko::zero<value_type>();
+    gko::remove_complex<value_type> scale = 0.0;
+    for (gko::size_type i = 0; i < size; ++i) {
+        const auto term = gko::conj(mtx_basis->at(i, 0)) * result->at(i, 0);
+        orthogonality += term;
+        scale += gko::abs(term);
+    }
+    ASSERT_LE(gko::abs(orthogonality), 10 * ::r<value_type>::value * scale);
+}
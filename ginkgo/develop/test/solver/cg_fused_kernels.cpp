@@ -0,0 +1,239 @@
+/*******************************<GINKGO LICENSE>******************************
+Copyright (c) 2017-2023, the Ginkgo authors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************<GINKGO LICENSE>*******************************/
+
+#include <memory>
+#include <random>
+
+
+#include <gtest/gtest.h>
+
+
+#include <ginkgo/core/base/array.hpp>
+#include <ginkgo/core/base/executor.hpp>
+#include <ginkgo/core/matrix/dense.hpp>
+#include <ginkgo/core/matrix/diagonal.hpp>
+#include <ginkgo/core/stop/stopping_status.hpp>
+
+
+#include "core/matrix/dense_kernels.hpp"
+#include "core/solver/cg_kernels.hpp"
+#include "core/test/utils.hpp"
+#include "core/test/utils/matrix_generator.hpp"
+#include "test/utils/executor.hpp"
+
+
+class CgFused : public CommonTestFixture {
+protected:
+    using Mtx = gko::matrix::Dense<value_type>;
+    using Diag = gko::matrix::Diagonal<value_type>;
+
+    CgFused() : rand_engine(30), tmp{ref}, d_tmp{exec} {}
+
+    std::unique_ptr<Mtx> gen_mtx(gko::size_type num_rows,
+                                 gko::size_type num_cols, gko::size_type stride)
+    {
+        auto tmp_mtx = gko::test::generate_random_matrix<Mtx>(
+            num_rows, num_cols,
+            std::uniform_int_distribution<>(num_cols, num_cols),
+            std::normal_distribution<value_type>(-1.0, 1.0), rand_engine, ref);
+        auto result = Mtx::create(ref, gko::dim<2>{num_rows, num_cols}, stride);
+        result->copy_from(tmp_mtx.get());
+        return result;
+    }
+
+    void initialize_data(gko::size_type m, gko::size_type n)
+    {
+        x = gen_mtx(m, n, n + 3);
+        r = gen_mtx(m, n, n + 2);
+        z = gen_mtx(m, n, n + 2);
+        p = gen_mtx(m, n, n + 2);
+        q = gen_mtx(m, n, n + 2);
+        beta = gen_mtx(1, n, n);
+        prev_rho = gen_mtx(1, n, n);
+        rho = gen_mtx(1, n, n);
+        inv_diag = Diag::create(ref, m);
+        std::uniform_real_distribution<gko::remove_complex<value_type>>
+            diag_dist(0.5, 2.0);
+        for (gko::size_type i = 0; i < m; ++i) {
+            inv_diag->get_values()[i] =
+                static_cast<value_type>(diag_dist(rand_engine));
+        }
+        stop_status =
+            std::make_unique<gko::array<gko::stopping_status>>(ref, n);
+        for (gko::size_type i = 0; i < n; ++i) {
+            stop_status->get_data()[i].reset();
+        }
+        if (n > 2) {
+            // check correct handling for zero values and stopped columns
+            beta->at(2) = 0.0;
+            stop_status->get_data()[1].stop(1);
+        }
+
+        d_x = gko::clone(exec, x);
+        d_r = gko::clone(exec, r);
+        d_z = gko::clone(exec, z);
+        d_p = gko::clone(exec, p);
+        d_q = gko::clone(exec, q);
+        d_beta = gko::clone(exec, beta);
+        d_prev_rho = gko::clone(exec, prev_rho);
+        d_rho = gko::clone(exec, rho);
+        d_inv_diag = gko::clone(exec, inv_diag);
+        d_stop_status = std::make_unique<gko::array<gko::stopping_status>>(
+            exec, *stop_status);
+    }
+
+    // runs the unfused reference kernels, with z = inv_diag * r as the
+    // right-hand side of the dot product if precondition is set
+    void step_2_and_conj_dot(bool precondition)
+    {
+        expected_prev_rho = gko::clone(rho);
+        gko::kernels::reference::cg::step_2(ref, x.get(), r.get(), p.get(),
+                                            q.get(), beta.get(), rho.get(),
+                                            stop_status.get());
+        if (precondition) {
+            const auto diag = inv_diag->get_const_values();
+            for (gko::size_type i = 0; i < z->get_size()[0]; ++i) {
+                for (gko::size_type j = 0; j < z->get_size()[1]; ++j) {
+                    z->at(i, j) = diag[i] * r->at(i, j);
+                }
+            }
+        }
+        gko::kernels::reference::dense::compute_conj_dot(
+            ref, r.get(), precondition ? z.get() : r.get(), rho.get(), tmp);
+    }
+
+    void step_2_fused()
+    {
+        gko::kernels::EXEC_NAMESPACE::cg::step_2_fused(
+            exec, d_x.get(), d_r.get(), d_p.get(), d_q.get(), d_beta.get(),
+            d_prev_rho.get(), d_rho.get(), d_tmp, d_stop_status.get());
+    }
+
+    void step_2_jacobi()
+    {
+        gko::kernels::EXEC_NAMESPACE::cg::step_2_jacobi(
+            exec, d_x.get(), d_r.get(), d_z.get(), d_p.get(), d_q.get(),
+            d_inv_diag.get(), d_beta.get(), d_prev_rho.get(), d_rho.get(),
+            d_tmp, d_stop_status.get());
+    }
+
+    void assert_step_2_results(const Mtx* prev_rho)
+    {
+        GKO_ASSERT_MTX_NEAR(d_x, x, ::r<value_type>::value);
+        GKO_ASSERT_MTX_NEAR(d_r, r, ::r<value_type>::value);
+        GKO_ASSERT_MTX_NEAR(d_prev_rho, prev_rho, 0.0);
+        GKO_ASSERT_MTX_NEAR(d_rho, rho, ::r<value_type>::value);
+    }
+
+    std::default_random_engine rand_engine;
+
+    std::unique_ptr<Mtx> x;
+    std::unique_ptr<Mtx> r;
+    std::unique_ptr<Mtx> z;
+    std::unique_ptr<Mtx> p;
+    std::unique_ptr<Mtx> q;
+    std::unique_ptr<Mtx> beta;
+    std::unique_ptr<Mtx> prev_rho;
+    std::unique_ptr<Mtx> rho;
+    std::unique_ptr<Diag> inv_diag;
+    std::unique_ptr<gko::array<gko::stopping_status>> stop_status;
+    std::unique_ptr<Mtx> expected_prev_rho;
+    gko::array<char> tmp;
+
+    std::unique_ptr<Mtx> d_x;
+    std::unique_ptr<Mtx> d_r;
+    std::unique_ptr<Mtx> d_z;
+    std::unique_ptr<Mtx> d_p;
+    std::unique_ptr<Mtx> d_q;
+    std::unique_ptr<Mtx> d_beta;
+    std::unique_ptr<Mtx> d_prev_rho;
+    std::unique_ptr<Mtx> d_rho;
+    std::unique_ptr<Diag> d_inv_diag;
+    std::unique_ptr<gko::array<gko::stopping_status>> d_stop_status;
+    gko::array<char> d_tmp;
+};
+
+
+TEST_F(CgFused, Step2FusedIsEquivalentToRef)
+{
+    for (auto n : {1, 4, 43}) {
+        SCOPED_TRACE(n);
+        initialize_data(597, n);
+
+        gko::kernels::reference::cg::step_2_fused(
+            ref, x.get(), r.get(), p.get(), q.get(), beta.get(),
+            prev_rho.get(), rho.get(), tmp, stop_status.get());
+        step_2_fused();
+
+        assert_step_2_results(prev_rho.get());
+    }
+}
+
+
+TEST_F(CgFused, Step2FusedIsEquivalentToStep2AndConjDot)
+{
+    initialize_data(597, 43);
+
+    step_2_and_conj_dot(false);
+    step_2_fused();
+
+    assert_step_2_results(expected_prev_rho.get());
+}
+
+
+TEST_F(CgFused, Step2JacobiIsEquivalentToRef)
+{
+    for (auto n : {1, 4, 43}) {
+        SCOPED_TRACE(n);
+        initialize_data(597, n);
+
+        gko::kernels::reference::cg::step_2_jacobi(
+            ref, x.get(), r.get(), z.get(), p.get(), q.get(), inv_diag.get(),
+            beta.get(), prev_rho.get(), rho.get(), tmp, stop_status.get());
+        step_2_jacobi();
+
+        GKO_ASSERT_MTX_NEAR(d_z, z, ::r<value_type>::value);
+        assert_step_2_results(prev_rho.get());
+    }
+}
+
+
+TEST_F(CgFused, Step2JacobiIsEquivalentToStep2ScaleAndConjDot)
+{
+    initialize_data(597, 43);
+
+    step_2_and_conj_dot(true);
+    step_2_jacobi();
+
+    GKO_ASSERT_MTX_NEAR(d_z, z, ::r<value_type>::value);
+    assert_step_2_results(expected_prev_rho.get());
+}
@@ -0,0 +1,191 @@
+/*******************************<GINKGO LICENSE>******************************
+Copyright (c) 2017-2023, the Ginkgo authors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************<GINKGO LICENSE>*******************************/
+
+#include <memory>
+#include <random>
+
+
+#include <gtest/gtest.h>
+
+
+#include <ginkgo/core/base/array.hpp>
+#include <ginkgo/core/base/executor.hpp>
+#include <ginkgo/core/base/math.hpp>
+#include <ginkgo/core/matrix/dense.hpp>
+#include <ginkgo/core/stop/stopping_status.hpp>
+
+
+#include "core/solver/cg_kernels.hpp"
+#include "core/test/utils.hpp"
+#include "core/test/utils/matrix_generator.hpp"
+#include "test/utils/executor.hpp"
+
+
+class CgMixed : public CommonTestFixture {
+protected:
+    using storage_type = gko::next_precision<value_type>;
+    using Mtx = gko::matrix::Dense<value_type>;
+    using StorageMtx = gko::matrix::Dense<storage_type>;
+
+    CgMixed() : rand_engine(11) {}
+
+    template <typename MtxType>
+    std::unique_ptr<MtxType> gen_mtx(gko::size_type num_rows,
+                                     gko::size_type num_cols,
+                                     gko::size_type stride)
+    {
+        auto tmp_mtx = gko::test::generate_random_matrix<Mtx>(
+            num_rows, num_cols,
+            std::uniform_int_distribution<>(num_cols, num_cols),
+            std::normal_distribution<value_type>(-1.0, 1.0), rand_engine, ref);
+        auto result =
+            MtxType::create(ref, gko::dim<2>{num_rows, num_cols}, stride);
+        result->copy_from(tmp_mtx.get());
+        return result;
+    }
+
+    void initialize_data(gko::size_type m, gko::size_type n)
+    {
+        x = gen_mtx<Mtx>(m, n, n + 1);
+        r = gen_mtx<Mtx>(m, n, n + 2);
+        p = gen_mtx<StorageMtx>(m, n, n + 3);
+        q = gen_mtx<StorageMtx>(m, n, n);
+        z = gen_mtx<StorageMtx>(m, n, n + 1);
+        beta = gen_mtx<Mtx>(1, n, n);
+        prev_rho = gen_mtx<Mtx>(1, n, n);
+        rho = gen_mtx<Mtx>(1, n, n);
+        stop_status =
+            std::make_unique<gko::array<gko::stopping_status>>(ref, n);
+        for (gko::size_type i = 0; i < n; ++i) {
+            stop_status->get_data()[i].reset();
+        }
+        if (n > 2) {
+            // check correct handling for zero values and stopped columns
+            prev_rho->at(2) = 0.0;
+            beta->at(2) = 0.0;
+            stop_status->get_data()[1].stop(1);
+        }
+
+        d_x = gko::clone(exec, x);
+        d_r = gko::clone(exec, r);
+        d_p = gko::clone(exec, p);
+        d_q = gko::clone(exec, q);
+        d_z = gko::clone(exec, z);
+        d_beta = gko::clone(exec, beta);
+        d_prev_rho = gko::clone(exec, prev_rho);
+        d_rho = gko::clone(exec, rho);
+        d_stop_status = std::make_unique<gko::array<gko::stopping_status>>(
+            exec, *stop_status);
+    }
+
+    std::default_random_engine rand_engine;
+
+    std::unique_ptr<Mtx> x;
+    std::unique_ptr<Mtx> r;
+    std::unique_ptr<StorageMtx> p;
+    std::unique_ptr<StorageMtx> q;
+    std::unique_ptr<StorageMtx> z;
+    std::unique_ptr<Mtx> beta;
+    std::unique_ptr<Mtx> prev_rho;
+    std::unique_ptr<Mtx> rho;
+    std::unique_ptr<gko::array<gko::stopping_status>> stop_status;
+
+    std::unique_ptr<Mtx> d_x;
+    std::unique_ptr<Mtx> d_r;
+    std::unique_ptr<StorageMtx> d_p;
+    std::unique_ptr<StorageMtx> d_q;
+    std::unique_ptr<StorageMtx> d_z;
+    std::unique_ptr<Mtx> d_beta;
+    std::unique_ptr<Mtx> d_prev_rho;
+    std::unique_ptr<Mtx> d_rho;
+    std::unique_ptr<gko::array<gko::stopping_status>> d_stop_status;
+};
+
+
+TEST_F(CgMixed, Step1MixedIsEquivalentToRef)
+{
+    for (gko::size_type n : {1, 4, 43}) {
+        SCOPED_TRACE(n);
+        initialize_data(597, n);
+
+        gko::kernels::reference::cg::step_1_mixed(
+            ref, p.get(), z.get(), rho.get(), prev_rho.get(),
+            stop_status.get());
+        gko::kernels::EXEC_NAMESPACE::cg::step_1_mixed(
+            exec, d_p.get(), d_z.get(), d_rho.get(), d_prev_rho.get(),
+            d_stop_status.get());
+
+        GKO_ASSERT_MTX_NEAR(d_p, p, ::r<storage_type>::value);
+    }
+}
+
+
+TEST_F(CgMixed, Step2MixedIsEquivalentToRef)
+{
+    for (gko::size_type n : {1, 4, 43}) {
+        SCOPED_TRACE(n);
+        initialize_data(597, n);
+
+        gko::kernels::reference::cg::step_2_mixed(
+            ref, x.get(), r.get(), p.get(), q.get(), beta.get(), rho.get(),
+            stop_status.get());
+        gko::kernels::EXEC_NAMESPACE::cg::step_2_mixed(
+            exec, d_x.get(), d_r.get(), d_p.get(), d_q.get(), d_beta.get(),
+            d_rho.get(), d_stop_status.get());
+
+        GKO_ASSERT_MTX_NEAR(d_x, x, ::r<value_type>::value);
+        GKO_ASSERT_MTX_NEAR(d_r, r, ::r<value_type>::value);
+    }
+}
+
+
+TEST_F(CgMixed, Step2MixedComputesInArithmeticPrecision)
+{
+    initialize_data(597, 4);
+    // step_2 on the stored directions converted to the arithmetic precision
+    auto p_value = Mtx::create(ref, p->get_size());
+    auto q_value = Mtx::create(ref, q->get_size());
+    p_value->copy_from(p.get());
+    q_value->copy_from(q.get());
+    auto expected_x = gko::clone(ref, x);
+    auto expected_r = gko::clone(ref, r);
+    gko::kernels::reference::cg::step_2(
+        ref, expected_x.get(), expected_r.get(), p_value.get(), q_value.get(),
+        beta.get(), rho.get(), stop_status.get());
+
+    gko::kernels::EXEC_NAMESPACE::cg::step_2_mixed(
+        exec, d_x.get(), d_r.get(), d_p.get(), d_q.get(), d_beta.get(),
+        d_rho.get(), d_stop_status.get());
+
+    GKO_ASSERT_MTX_NEAR(d_x, expected_x, ::r<value_type>::value);
+    GKO_ASSERT_MTX_NEAR(d_r, expected_r, ::r<value_type>::value);
+}
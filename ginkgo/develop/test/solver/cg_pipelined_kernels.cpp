@@ -0,0 +1,282 @@
+/*******************************<GINKGO LICENSE>******************************
+Copyright (c) 2017-2023, the Ginkgo authors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************<GINKGO LICENSE>*******************************/
+
+#include <memory>
+#include <random>
+
+
+#include <gtest/gtest.h>
+
+
+#include <ginkgo/core/base/array.hpp>
+#include <ginkgo/core/base/executor.hpp>
+#include <ginkgo/core/matrix/dense.hpp>
+#include <ginkgo/core/stop/stopping_status.hpp>
+
+
+#include "core/matrix/dense_kernels.hpp"
+#include "core/solver/cg_kernels.hpp"
+#include "core/test/utils.hpp"
+#include "core/test/utils/matrix_generator.hpp"
+#include "test/utils/executor.hpp"
+
+
+class CgPipelined : public CommonTestFixture {
+protected:
+    using Mtx = gko::matrix::Dense<value_type>;
+
+    CgPipelined() : rand_engine(42), tmp{ref}, d_tmp{exec} {}
+
+    std::unique_ptr<Mtx> gen_mtx(gko::size_type num_rows,
+                                 gko::size_type num_cols, gko::size_type stride)
+    {
+        auto tmp_mtx = gko::test::generate_random_matrix<Mtx>(
+            num_rows, num_cols,
+            std::uniform_int_distribution<>(num_cols, num_cols),
+            std::normal_distribution<value_type>(-1.0, 1.0), rand_engine, ref);
+        auto result = Mtx::create(ref, gko::dim<2>{num_rows, num_cols}, stride);
+        result->copy_from(tmp_mtx.get());
+        return result;
+    }
+
+    void initialize_data(gko::size_type m, gko::size_type n)
+    {
+        x = gen_mtx(m, n, n + 3);
+        r = gen_mtx(m, n, n + 2);
+        u = gen_mtx(m, n, n + 2);
+        w = gen_mtx(m, n, n + 2);
+        p = gen_mtx(m, n, n + 2);
+        q = gen_mtx(m, n, n + 2);
+        s = gen_mtx(m, n, n + 2);
+        z = gen_mtx(m, n, n + 2);
+        mw = gen_mtx(m, n, n + 2);
+        nw = gen_mtx(m, n, n + 2);
+        dots = gen_mtx(1, 2 * n, 2 * n);
+        prev_rho = gen_mtx(1, n, n);
+        alpha = gen_mtx(1, n, n);
+        stop_status =
+            std::make_unique<gko::array<gko::stopping_status>>(ref, n);
+        for (gko::size_type i = 0; i < n; ++i) {
+            stop_status->get_data()[i].reset();
+        }
+        if (n > 2) {
+            // check correct handling for zero values and stopped columns
+            prev_rho->at(2) = 0.0;
+            stop_status->get_data()[1].stop(1);
+        }
+
+        d_x = gko::clone(exec, x);
+        d_r = gko::clone(exec, r);
+        d_u = gko::clone(exec, u);
+        d_w = gko::clone(exec, w);
+        d_p = gko::clone(exec, p);
+        d_q = gko::clone(exec, q);
+        d_s = gko::clone(exec, s);
+        d_z = gko::clone(exec, z);
+        d_mw = gko::clone(exec, mw);
+        d_nw = gko::clone(exec, nw);
+        d_dots = gko::clone(exec, dots);
+        d_prev_rho = gko::clone(exec, prev_rho);
+        d_alpha = gko::clone(exec, alpha);
+        d_stop_status = std::make_unique<gko::array<gko::stopping_status>>(
+            exec, *stop_status);
+    }
+
+    std::default_random_engine rand_engine;
+
+    std::unique_ptr<Mtx> x;
+    std::unique_ptr<Mtx> r;
+    std::unique_ptr<Mtx> u;
+    std::unique_ptr<Mtx> w;
+    std::unique_ptr<Mtx> p;
+    std::unique_ptr<Mtx> q;
+    std::unique_ptr<Mtx> s;
+    std::unique_ptr<Mtx> z;
+    std::unique_ptr<Mtx> mw;
+    std::unique_ptr<Mtx> nw;
+    std::unique_ptr<Mtx> dots;
+    std::unique_ptr<Mtx> prev_rho;
+    std::unique_ptr<Mtx> alpha;
+    std::unique_ptr<gko::array<gko::stopping_status>> stop_status;
+    gko::array<char> tmp;
+
+    std::unique_ptr<Mtx> d_x;
+    std::unique_ptr<Mtx> d_r;
+    std::unique_ptr<Mtx> d_u;
+    std::unique_ptr<Mtx> d_w;
+    std::unique_ptr<Mtx> d_p;
+    std::unique_ptr<Mtx> d_q;
+    std::unique_ptr<Mtx> d_s;
+    std::unique_ptr<Mtx> d_z;
+    std::unique_ptr<Mtx> d_mw;
+    std::unique_ptr<Mtx> d_nw;
+    std::unique_ptr<Mtx> d_dots;
+    std::unique_ptr<Mtx> d_prev_rho;
+    std::unique_ptr<Mtx> d_alpha;
+    std::unique_ptr<gko::array<gko::stopping_status>> d_stop_status;
+    gko::array<char> d_tmp;
+};
+
+
+TEST_F(CgPipelined, InitializeIsEquivalentToRef)
+{
+    initialize_data(597, 43);
+    auto b = gen_mtx(597, 43, 45);
+    auto d_b = gko::clone(exec, b);
+
+    gko::kernels::reference::cg::initialize_pipelined(
+        ref, b.get(), r.get(), p.get(), q.get(), s.get(), z.get(),
+        prev_rho.get(), alpha.get(), stop_status.get());
+    gko::kernels::EXEC_NAMESPACE::cg::initialize_pipelined(
+        exec, d_b.get(), d_r.get(), d_p.get(), d_q.get(), d_s.get(), d_z.get(),
+        d_prev_rho.get(), d_alpha.get(), d_stop_status.get());
+
+    GKO_ASSERT_MTX_NEAR(d_r, r, 0.0);
+    GKO_ASSERT_MTX_NEAR(d_p, p, 0.0);
+    GKO_ASSERT_MTX_NEAR(d_q, q, 0.0);
+    GKO_ASSERT_MTX_NEAR(d_s, s, 0.0);
+    GKO_ASSERT_MTX_NEAR(d_z, z, 0.0);
+    GKO_ASSERT_MTX_NEAR(d_prev_rho, prev_rho, 0.0);
+    GKO_ASSERT_MTX_NEAR(d_alpha, alpha, 0.0);
+}
+
+
+TEST_F(CgPipelined, Step1IsEquivalentToRef)
+{
+    for (auto n : {1, 4, 43}) {
+        SCOPED_TRACE(n);
+        initialize_data(597, n);
+
+        gko::kernels::reference::cg::step_1_pipelined(
+            ref, r.get(), u.get(), w.get(), dots.get(), tmp);
+        gko::kernels::EXEC_NAMESPACE::cg::step_1_pipelined(
+            exec, d_r.get(), d_u.get(), d_w.get(), d_dots.get(), d_tmp);
+
+        GKO_ASSERT_MTX_NEAR(d_dots, dots, ::r<value_type>::value);
+    }
+}
+
+
+TEST_F(CgPipelined, Step2IsEquivalentToRef)
+{
+    for (auto n : {1, 4, 43}) {
+        SCOPED_TRACE(n);
+        initialize_data(597, n);
+
+        gko::kernels::reference::cg::step_2_pipelined(
+            ref, x.get(), r.get(), u.get(), w.get(), p.get(), q.get(), s.get(),
+            z.get(), mw.get(), nw.get(), dots.get(), prev_rho.get(),
+            alpha.get(), stop_status.get());
+        gko::kernels::EXEC_NAMESPACE::cg::step_2_pipelined(
+            exec, d_x.get(), d_r.get(), d_u.get(), d_w.get(), d_p.get(),
+            d_q.get(), d_s.get(), d_z.get(), d_mw.get(), d_nw.get(),
+            d_dots.get(), d_prev_rho.get(), d_alpha.get(),
+            d_stop_status.get());
+
+        GKO_ASSERT_MTX_NEAR(d_x, x, ::r<value_type>::value);
+        GKO_ASSERT_MTX_NEAR(d_r, r, ::r<value_type>::value);
+        GKO_ASSERT_MTX_NEAR(d_u, u, ::r<value_type>::value);
+        GKO_ASSERT_MTX_NEAR(d_w, w, ::r<value_type>::value);
+        GKO_ASSERT_MTX_NEAR(d_p, p, ::r<value_type>::value);
+        GKO_ASSERT_MTX_NEAR(d_q, q, ::r<value_type>::value);
+        GKO_ASSERT_MTX_NEAR(d_s, s, ::r<value_type>::value);
+        GKO_ASSERT_MTX_NEAR(d_z, z, ::r<value_type>::value);
+        GKO_ASSERT_MTX_NEAR(d_prev_rho, prev_rho, 0.0);
+        GKO_ASSERT_MTX_NEAR(d_alpha, alpha, ::r<value_type>::value);
+    }
+}
+
+
+TEST_F(CgPipelined, IteratesLikeCg)
+{
+    const gko::size_type size = 50;
+    const gko::size_type num_cols = 3;
+    // A = B^T B / size + I is well-conditioned and SPD
+    auto rand = gen_mtx(size, size, size);
+    auto mtx = Mtx::create(ref, gko::dim<2>{size, size});
+    for (gko::size_type i = 0; i < size; ++i) {
+        for (gko::size_type j = 0; j < size; ++j) {
+            mtx->at(i, j) = i == j ? 1.0 : 0.0;
+            for (gko::size_type k = 0; k < size; ++k) {
+                mtx->at(i, j) += rand->at(k, i) * rand->at(k, j) /
+                                 static_cast<value_type>(size);
+            }
+        }
+    }
+    auto b = gen_mtx(size, num_cols, num_cols);
+    initialize_data(size, num_cols);
+    x->fill(0.0);
+    d_x->fill(0.0);
+    auto d_mtx = gko::clone(exec, mtx);
+    auto d_b = gko::clone(exec, b);
+    auto beta = gen_mtx(1, num_cols, num_cols);
+    auto rho = gen_mtx(1, num_cols, num_cols);
+
+    gko::kernels::reference::cg::initialize(ref, b.get(), r.get(), z.get(),
+                                            p.get(), q.get(), prev_rho.get(),
+                                            rho.get(), stop_status.get());
+    gko::kernels::EXEC_NAMESPACE::cg::initialize_pipelined(
+        exec, d_b.get(), d_r.get(), d_p.get(), d_q.get(), d_s.get(), d_z.get(),
+        d_prev_rho.get(), d_alpha.get(), d_stop_status.get());
+    gko::kernels::EXEC_NAMESPACE::dense::copy(exec, d_r.get(), d_u.get());
+    gko::kernels::EXEC_NAMESPACE::dense::simple_apply(exec, d_mtx.get(),
+                                                      d_u.get(), d_w.get());
+    for (int iteration = 0; iteration < 5; ++iteration) {
+        gko::kernels::reference::dense::copy(ref, r.get(), z.get());
+        gko::kernels::reference::dense::compute_conj_dot(ref, r.get(), z.get(),
+                                                         rho.get(), tmp);
+        gko::kernels::reference::cg::step_1(ref, p.get(), z.get(), rho.get(),
+                                            prev_rho.get(), stop_status.get());
+        gko::kernels::reference::dense::simple_apply(ref, mtx.get(), p.get(),
+                                                     q.get());
+        gko::kernels::reference::dense::compute_conj_dot(ref, p.get(), q.get(),
+                                                         beta.get(), tmp);
+        gko::kernels::reference::cg::step_2(ref, x.get(), r.get(), p.get(),
+                                            q.get(), beta.get(), rho.get(),
+                                            stop_status.get());
+        std::swap(prev_rho, rho);
+        gko::kernels::EXEC_NAMESPACE::cg::step_1_pipelined(
+            exec, d_r.get(), d_u.get(), d_w.get(), d_dots.get(), d_tmp);
+        gko::kernels::EXEC_NAMESPACE::dense::copy(exec, d_w.get(), d_mw.get());
+        gko::kernels::EXEC_NAMESPACE::dense::simple_apply(
+            exec, d_mtx.get(), d_mw.get(), d_nw.get());
+        gko::kernels::EXEC_NAMESPACE::cg::step_2_pipelined(
+            exec, d_x.get(), d_r.get(), d_u.get(), d_w.get(), d_p.get(),
+            d_q.get(), d_s.get(), d_z.get(), d_mw.get(), d_nw.get(),
+            d_dots.get(), d_prev_rho.get(), d_alpha.get(),
+            d_stop_status.get());
+    }
+
+    // the recurrences for r drift apart in the last digits, so only the
+    // iterates are compared
+    GKO_ASSERT_MTX_NEAR(d_x, x, 1e3 * ::r<value_type>::value);
+}
@@ -0,0 +1,182 @@
+/*******************************<GINKGO LICENSE>******************************
+Copyright (c) 2017-2023, the Ginkgo authors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************<GINKGO LICENSE>*******************************/
+
+#include <memory>
+#include <random>
+#include <vector>
+
+
+#include <gtest/gtest.h>
+
+
+#include <ginkgo/core/base/array.hpp>
+#include <ginkgo/core/base/executor.hpp>
+#include <ginkgo/core/matrix/dense.hpp>
+#include <ginkgo/core/stop/stopping_status.hpp>
+
+
+#include "core/solver/cg_kernels.hpp"
+#include "core/test/utils.hpp"
+#include "core/test/utils/matrix_generator.hpp"
+#include "test/utils/executor.hpp"
+
+
+// The OpenMP CG updates have fixed-width implementations for 1, 2, 4 and 8
+// columns that are only used if all columns are active with a nonzero
+// coefficient. These tests cover both these and the fallback cases.
+class CgSmallWidth : public CommonTestFixture {
+protected:
+    using Mtx = gko::matrix::Dense<value_type>;
+
+    enum class column_state { all_active, one_stopped, one_zero_coefficient };
+
+    CgSmallWidth() : rand_engine(5) {}
+
+    std::unique_ptr<Mtx> gen_mtx(gko::size_type num_rows,
+                                 gko::size_type num_cols, gko::size_type stride)
+    {
+        auto tmp_mtx = gko::test::generate_random_matrix<Mtx>(
+            num_rows, num_cols,
+            std::uniform_int_distribution<>(num_cols, num_cols),
+            std::normal_distribution<value_type>(-1.0, 1.0), rand_engine, ref);
+        auto result = Mtx::create(ref, gko::dim<2>{num_rows, num_cols}, stride);
+        result->copy_from(tmp_mtx.get());
+        return result;
+    }
+
+    void initialize_data(gko::size_type n, column_state state)
+    {
+        const gko::size_type m = 1001;
+        x = gen_mtx(m, n, n + 1);
+        r = gen_mtx(m, n, n + 2);
+        z = gen_mtx(m, n, n);
+        p = gen_mtx(m, n, n + 3);
+        q = gen_mtx(m, n, n + 1);
+        beta = gen_mtx(1, n, n);
+        prev_rho = gen_mtx(1, n, n);
+        rho = gen_mtx(1, n, n);
+        stop_status =
+            std::make_unique<gko::array<gko::stopping_status>>(ref, n);
+        for (gko::size_type i = 0; i < n; ++i) {
+            stop_status->get_data()[i].reset();
+        }
+        const auto last = n - 1;
+        if (state == column_state::one_stopped) {
+            stop_status->get_data()[last].stop(1);
+        } else if (state == column_state::one_zero_coefficient) {
+            // zero step_1 and step_2 coefficients
+            rho->at(last) = 0.0;
+        }
+
+        d_x = gko::clone(exec, x);
+        d_r = gko::clone(exec, r);
+        d_z = gko::clone(exec, z);
+        d_p = gko::clone(exec, p);
+        d_q = gko::clone(exec, q);
+        d_beta = gko::clone(exec, beta);
+        d_prev_rho = gko::clone(exec, prev_rho);
+        d_rho = gko::clone(exec, rho);
+        d_stop_status = std::make_unique<gko::array<gko::stopping_status>>(
+            exec, *stop_status);
+    }
+
+    static std::vector<column_state> column_states()
+    {
+        return {column_state::all_active, column_state::one_stopped,
+                column_state::one_zero_coefficient};
+    }
+
+    std::default_random_engine rand_engine;
+
+    std::unique_ptr<Mtx> x;
+    std::unique_ptr<Mtx> r;
+    std::unique_ptr<Mtx> z;
+    std::unique_ptr<Mtx> p;
+    std::unique_ptr<Mtx> q;
+    std::unique_ptr<Mtx> beta;
+    std::unique_ptr<Mtx> prev_rho;
+    std::unique_ptr<Mtx> rho;
+    std::unique_ptr<gko::array<gko::stopping_status>> stop_status;
+
+    std::unique_ptr<Mtx> d_x;
+    std::unique_ptr<Mtx> d_r;
+    std::unique_ptr<Mtx> d_z;
+    std::unique_ptr<Mtx> d_p;
+    std::unique_ptr<Mtx> d_q;
+    std::unique_ptr<Mtx> d_beta;
+    std::unique_ptr<Mtx> d_prev_rho;
+    std::unique_ptr<Mtx> d_rho;
+    std::unique_ptr<gko::array<gko::stopping_status>> d_stop_status;
+};
+
+
+TEST_F(CgSmallWidth, Step1IsEquivalentToRef)
+{
+    for (gko::size_type n : {1, 2, 4, 8}) {
+        for (auto state : column_states()) {
+            SCOPED_TRACE(n);
+            SCOPED_TRACE(static_cast<int>(state));
+            initialize_data(n, state);
+
+            gko::kernels::reference::cg::step_1(ref, p.get(), z.get(),
+                                                rho.get(), prev_rho.get(),
+                                                stop_status.get());
+            gko::kernels::EXEC_NAMESPACE::cg::step_1(
+                exec, d_p.get(), d_z.get(), d_rho.get(), d_prev_rho.get(),
+                d_stop_status.get());
+
+            GKO_ASSERT_MTX_NEAR(d_p, p, ::r<value_type>::value);
+        }
+    }
+}
+
+
+TEST_F(CgSmallWidth, Step2IsEquivalentToRef)
+{
+    for (gko::size_type n : {1, 2, 4, 8}) {
+        for (auto state : column_states()) {
+            SCOPED_TRACE(n);
+            SCOPED_TRACE(static_cast<int>(state));
+            initialize_data(n, state);
+
+            gko::kernels::reference::cg::step_2(
+                ref, x.get(), r.get(), p.get(), q.get(), beta.get(),
+                rho.get(), stop_status.get());
+            gko::kernels::EXEC_NAMESPACE::cg::step_2(
+                exec, d_x.get(), d_r.get(), d_p.get(), d_q.get(),
+                d_beta.get(), d_rho.get(), d_stop_status.get());
+
+            GKO_ASSERT_MTX_NEAR(d_x, x, ::r<value_type>::value);
+            GKO_ASSERT_MTX_NEAR(d_r, r, ::r<value_type>::value);
+        }
+    }
+}
@@ -0,0 +1,34 @@
+#include <stdlib.h>
+#include <math.h>
+void step_2_jacobi(
+    const size_t x_size_0,
+    const size_t x_size_1,
+    const double_t *beta_values,
+    const double_t *inv_diag_values,
+    const double_t **p_values,
+    const double_t **q_values,
+    double_t **x_values,
+    double_t **r_values,
+    double_t **z_values,
+    double_t *prev_rho_values,
+    double_t *rho_values) {
+    size_t i, j;
+    double_t *tmp = malloc(sizeof(double_t[x_size_1]));
+    for (j = 0; j < x_size_1; ++j)
+        tmp[j] = rho_values[j] / beta_values[j];
+#pragma scop
+    for (j = 0; j < x_size_1; ++j) {
+        prev_rho_values[j] = rho_values[j];
+        rho_values[j] = 0;
+    }
+    for (i = 0; i < x_size_0; ++i) {
+        for (j = 0; j < x_size_1; ++j) {
+            x_values[i][j] += tmp[j] * p_values[i][j];
+            r_values[i][j] -= tmp[j] * q_values[i][j];
+            z_values[i][j] = inv_diag_values[i] * r_values[i][j];
+            rho_values[j] += r_values[i][j] * z_values[i][j];
+        }
+    }
+#pragma endscop
+    free(tmp);
+}